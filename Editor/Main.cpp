@@ -36,6 +36,7 @@ aryanbaburajan2007@gmail.com
 #include <Panels/SceneViewPanel.h>
 #include <Panels/DucktapeEditorPanel.h>
 #include <Panels/ComponentMenuPanel.h>
+#include <Panels/StatisticsPanel.h>
 using namespace DT;
 
 int main()
@@ -82,6 +83,7 @@ int main()
         Editor::AddPanel<ProjectPanel>();
         Editor::AddPanel<DucktapeEditorPanel>();
         Editor::AddPanel<ComponentMenuPanel>();
+        Editor::AddPanel<StatisticsPanel>();
         ResourceInterface::AddDefault(ctx.pointer);
 
         Editor::Init(ctx.pointer);
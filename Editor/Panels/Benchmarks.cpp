@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <entt/entt.hpp>
+
+#include <Core/JobSystem.h>
+#include <Components/Transform.h>
+#include <Components/Relation.h>
+#include <Panels/Benchmarks.h>
+
+namespace DT
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        double Elapsed(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        struct ModelMatrix
+        {
+            glm::mat4 value;
+        };
+    }
+
+    void Benchmarks::JobSystemScaling(unsigned int entityCount)
+    {
+        entt::registry registry;
+        for (unsigned int i = 0; i < entityCount; i++)
+        {
+            Entity entity = registry.create();
+            Transform &transform = registry.emplace<Transform>(entity);
+            transform.translation = glm::vec3((float)i, (float)(i % 7), (float)(i % 13));
+            transform.rotation = glm::angleAxis((float)i, glm::normalize(glm::vec3(1.f, 2.f, 3.f)));
+            registry.emplace<ModelMatrix>(entity);
+        }
+        auto view = registry.view<Transform, ModelMatrix>();
+
+        const unsigned int repeats = 10, emptyJobs = 100000;
+        double singleThreaded = 0.0;
+
+        for (unsigned int threads = 1; threads <= std::max(std::thread::hardware_concurrency(), 1u); threads++)
+        {
+            // The benchmarking thread takes part too
+            JobSystem jobSystem(threads - 1);
+
+            double best = 0.0;
+            for (unsigned int repeat = 0; repeat < repeats; repeat++)
+            {
+                Clock::time_point start = Clock::now();
+                jobSystem.ParallelForEach(view, [&view](Entity entity)
+                                          { view.get<ModelMatrix>(entity).value = view.get<Transform>(entity).GetModelMatrix(); });
+                double time = Elapsed(start);
+                best = repeat == 0 ? time : std::min(best, time);
+            }
+            if (threads == 1)
+                singleThreaded = best;
+
+            Clock::time_point start = Clock::now();
+            JobSystem::Counter counter;
+            for (unsigned int i = 0; i < emptyJobs; i++)
+                jobSystem.Submit([]() {}, &counter);
+            jobSystem.Wait(counter);
+            double overhead = Elapsed(start) * 1000000.0 / emptyJobs;
+
+            std::cout << "[LOG] " << threads << " threads: " << best << " ms for " << entityCount << " model matrices, "
+                      << singleThreaded / best << "x speedup, " << overhead << " ns per empty job\n";
+        }
+    }
+
+    void Benchmarks::Hierarchy(unsigned int nodeCount)
+    {
+        entt::registry registry;
+        std::vector<Entity> nodes(nodeCount);
+        for (Entity &node : nodes)
+        {
+            node = registry.create();
+            Transform &transform = registry.emplace<Transform>(node);
+            transform.translation = glm::vec3(1.f, 0.f, 0.f);
+            transform.rotation = glm::angleAxis(0.1f, glm::vec3(0.f, 1.f, 0.f));
+            registry.emplace<Relation>(node);
+        }
+
+        // Random parents among the earlier nodes scatter the children of a node all over the storages
+        Clock::time_point start = Clock::now();
+        uint32_t random = 12345;
+        for (unsigned int i = 16; i < nodeCount; i++)
+        {
+            random = random * 1664525u + 1013904223u;
+            Relation::Link(nodes[random % i], nodes[i], registry);
+        }
+        double linkTime = Elapsed(start);
+
+        start = Clock::now();
+        const HierarchyOrder &order = HierarchyOrder::Get(registry);
+        double sortTime = Elapsed(start);
+
+        // Depth first through the sibling links, the way the scene panel draws the hierarchy
+        start = Clock::now();
+        size_t visited = 0;
+        std::vector<Entity> stack;
+        for (unsigned int i = 0; i < 16; i++)
+        {
+            stack.push_back(nodes[i]);
+            while (!stack.empty())
+            {
+                Entity entity = stack.back();
+                stack.pop_back();
+                visited++;
+                registry.get<Relation>(entity).ForEachChild(registry, [&stack](Entity child)
+                                                            { stack.push_back(child); });
+            }
+        }
+        double linkWalkTime = Elapsed(start);
+
+        start = Clock::now();
+        size_t scanned = 0;
+        for (Entity entity : order.entities)
+            scanned += registry.get<Relation>(entity).childCount;
+        double scanTime = Elapsed(start);
+
+        JobSystem jobSystem;
+        TransformSystem transformSystem;
+
+        start = Clock::now();
+        transformSystem.Propagate(registry, jobSystem);
+        double firstTime = Elapsed(start);
+
+        const unsigned int repeats = 10;
+        start = Clock::now();
+        for (unsigned int repeat = 0; repeat < repeats; repeat++)
+            transformSystem.Propagate(registry, jobSystem);
+        double staticTime = Elapsed(start) / repeats;
+
+        start = Clock::now();
+        for (unsigned int repeat = 0; repeat < repeats; repeat++)
+        {
+            for (unsigned int i = 0; i < 16; i++)
+                registry.get<Transform>(nodes[i]).translation.y += 1.f;
+            transformSystem.Propagate(registry, jobSystem);
+        }
+        double movedTime = Elapsed(start) / repeats;
+
+        std::cout << "[LOG] Hierarchy of " << nodeCount << " nodes: linked in " << linkTime << " ms, sorted in " << sortTime << " ms\n";
+        std::cout << "[LOG] Walked " << visited << " nodes through sibling links in " << linkWalkTime << " ms, scanned "
+                  << order.entities.size() << " nodes (" << scanned << " children) in order in " << scanTime << " ms\n";
+        std::cout << "[LOG] Transform propagation: " << firstTime << " ms first, " << staticTime << " ms unchanged, "
+                  << movedTime << " ms with every root moved (" << jobSystem.GetWorkerCount() + 1 << " threads)\n";
+    }
+
+    void Benchmarks::Iteration(unsigned int entityCount)
+    {
+        entt::registry registry;
+        for (unsigned int i = 0; i < entityCount; i++)
+        {
+            Entity entity = registry.create();
+            registry.emplace<Transform>(entity).translation = glm::vec3((float)i, 0.f, 0.f);
+            if (i % 2 == 0)
+                registry.emplace<ModelMatrix>(entity).value = glm::mat4((float)i);
+        }
+
+        const unsigned int repeats = 10;
+        glm::vec4 sum(0.f);
+        auto best = [&](auto &&iterate)
+        {
+            double time = 0.0;
+            for (unsigned int repeat = 0; repeat < repeats; repeat++)
+            {
+                Clock::time_point start = Clock::now();
+                iterate();
+                time = repeat == 0 ? Elapsed(start) : std::min(time, Elapsed(start));
+            }
+            return time * 1000000.0 / (entityCount / 2);
+        };
+
+        // What the systems used to do: walk one storage, then check for and fetch every component by entity
+        double lookupTime = best([&]()
+                                 {
+                                     for (Entity entity : registry.view<ModelMatrix>())
+                                     {
+                                         if (!registry.any_of<ModelMatrix>(entity) || !registry.any_of<Transform>(entity))
+                                             continue;
+                                         sum += registry.get<ModelMatrix>(entity).value[0] + glm::vec4(registry.get<Transform>(entity).translation, 0.f);
+                                     } });
+
+        auto view = registry.view<ModelMatrix, Transform>();
+        double eachTime = best([&]()
+                               {
+                                   for (auto [entity, model, transform] : view.each())
+                                       sum += model.value[0] + glm::vec4(transform.translation, 0.f);
+                               });
+
+        // Owns the model matrices only, like the MeshRendererSystem group, the Transform storage can't be reordered
+        auto group = registry.group<ModelMatrix>(entt::get<Transform>);
+        double groupTime = best([&]()
+                                {
+                                    for (auto [entity, model, transform] : group.each())
+                                        sum += model.value[0] + glm::vec4(transform.translation, 0.f);
+                                });
+
+        std::cout << "[LOG] Iterating " << entityCount / 2 << " of " << entityCount << " entities: " << lookupTime << " ns per entity with lookups, "
+                  << eachTime << " ns with view.each(), " << groupTime << " ns with an owning group (checksum " << sum.x << ")\n";
+    }
+}
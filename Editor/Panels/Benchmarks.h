@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Core/ContextPtr.h>
+
+namespace DT
+{
+    /**
+     * @brief Engine micro benchmarks run from the Tools menu, results go to the log.
+     */
+    namespace Benchmarks
+    {
+        /**
+         * @brief Computes the model matrices of entityCount entities with ParallelForEach on 1 to hardware concurrency
+         * threads and logs the time and speedup of each, along with the overhead of submitting empty jobs.
+         */
+        void JobSystemScaling(unsigned int entityCount = 200000);
+
+        /**
+         * @brief Builds a hierarchy of nodeCount entities with random parents and logs the time it takes to link it,
+         * sort it, walk it through the sibling links and in HierarchyOrder, and propagate its transforms.
+         */
+        void Hierarchy(unsigned int nodeCount = 100000);
+
+        /**
+         * @brief Logs the cost per entity of copying model matrices out of entityCount entities, half of which have one,
+         * through a view with a lookup per component, view.each() and a group owning the model matrices.
+         */
+        void Iteration(unsigned int entityCount = 200000);
+    }
+}
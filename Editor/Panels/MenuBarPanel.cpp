@@ -57,6 +57,8 @@ namespace DT
                     Editor::GetPanel<ResourceInspectorPanel>()->isOpen = true;
                 if (ImGui::MenuItem("Project Browser"))
                     Editor::GetPanel<DucktapeEditorPanel>()->isOpen = true;
+                if (ImGui::MenuItem("Statistics"))
+                    Editor::GetPanel<StatisticsPanel>()->isOpen = true;
                 ImGui::EndMenu();
             }
             if (ImGui::BeginMenu("Editor"))
@@ -67,6 +69,32 @@ namespace DT
                 }
                 ImGui::EndMenu();
             }
+            if (ImGui::BeginMenu("Tools"))
+            {
+                if (ImGui::MenuItem("Convert meshes to binary"))
+                    ResourceInterface::ConvertMeshes(ctx);
+                if (ImGui::MenuItem("Benchmark resource manager"))
+                    ResourceInterface::BenchmarkResourceManager();
+                if (ImGui::MenuItem("Build asset pack"))
+                    ResourceInterface::BuildPack(ctx, PackFile::Compression::LZ4);
+                if (ImGui::MenuItem("Build distribution asset pack"))
+                    ResourceInterface::BuildPack(ctx, PackFile::Compression::LZ4High);
+                if (ImGui::MenuItem("Benchmark pack compression"))
+                    ResourceInterface::BenchmarkCompression(ctx);
+                if (ImGui::MenuItem("Compress textures"))
+                    ResourceInterface::CompressTextures(ctx);
+                if (ImGui::MenuItem("Import cache report"))
+                    ImportCache::Report();
+                if (ImGui::MenuItem("Clear import cache"))
+                    ImportCache::Clear();
+                if (ImGui::MenuItem("Benchmark job system"))
+                    Benchmarks::JobSystemScaling();
+                if (ImGui::MenuItem("Benchmark hierarchy"))
+                    Benchmarks::Hierarchy();
+                if (ImGui::MenuItem("Benchmark component iteration"))
+                    Benchmarks::Iteration();
+                ImGui::EndMenu();
+            }
             ImGui::EndMainMenuBar();
         }
 
@@ -10,6 +10,8 @@
 #include <Panels/ResourceInspectorPanel.h>
 #include <Panels/DucktapeEditorPanel.h>
 #include <Panels/SceneViewPanel.h>
+#include <Panels/StatisticsPanel.h>
+#include <Panels/Benchmarks.h>
 #include <Components/Camera.h>
 #include <Components/Transform.h>
 #include <Components/Tag.h>
@@ -392,8 +392,8 @@ namespace DT
         // Note that icons are from https://www.icons8.com and not fully copyright free.
         // TODO: Add self drawn icons
 
-        folderIconId = Texture::LoadResource(ctx.resourceManager->GetRID(resourceDir / "Icons" / "ResourceBrowser" / "folder.png"), ctx)->id;
-        fileIconId = Texture::LoadResource(ctx.resourceManager->GetRID(resourceDir / "Icons" / "ResourceBrowser" / "file.png"), ctx)->id;
+        folderIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(resourceDir / "Icons" / "ResourceBrowser" / "folder.png"), ctx)->id;
+        fileIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(resourceDir / "Icons" / "ResourceBrowser" / "file.png"), ctx)->id;
     }
 
     /// @brief Called when this panel is updated each frame.
@@ -4,7 +4,7 @@ namespace DT
 {
     void MaterialInterface::Init(ContextPtr& ctx)
     {
-        iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "material.png"), ctx)->id;
+        iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "material.png"), ctx)->id;
     }
 
     void MaterialInterface::OpenInspect(RID rid, ContextPtr& ctx)
@@ -58,7 +58,7 @@ namespace DT
 
     void TextureInterface::Init(ContextPtr &ctx)
     {
-        iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "image.png"), ctx)->id;
+        iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "image.png"), ctx)->id;
     }
 
     void TextureInterface::OpenInspect(RID rid, ContextPtr& ctx)
@@ -74,6 +74,9 @@ namespace DT
 
         ImGui::Separator();
 
+        ImGui::Text("%d x %d, %.2f MB video memory%s", openedTexture.data->width, openedTexture.data->height, openedTexture.data->GetGPUMemory() / 1048576.f,
+                    openedTexture.data->compressedSize > 0 ? ", block compressed" : "");
+
         ImGui::Image((ImTextureID)(uintptr_t)openedTexture.data->id, ImVec2(ImGui::GetWindowContentRegionWidth(), openedTexture.data->height * (ImGui::GetWindowContentRegionWidth() / openedTexture.data->width)), ImVec2(0, 1), ImVec2(1, 0));
     }
 
@@ -84,7 +87,7 @@ namespace DT
 
     void MeshInterface::Init(ContextPtr &ctx)
     {
-        iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "mesh.png"), ctx)->id;
+        iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "mesh.png"), ctx)->id;
     }
 
     void MeshInterface::OpenInspect(RID rid, ContextPtr& ctx)
@@ -110,34 +113,226 @@ namespace DT
         openedMesh.Save(ctx);
     }
 
+    namespace ImportCache
+    {
+        std::filesystem::path GetDirectory()
+        {
+            return DUCKTAPE_ROOT_DIR / "Cache" / "Imports";
+        }
+
+        std::string GetKey(const std::filesystem::path &source, const std::string &settings)
+        {
+            Platform::MappedFile file;
+            if (!file.Open(source))
+                return "";
+
+            char key[34];
+            std::snprintf(key, sizeof(key), "%016llx%016llx", static_cast<unsigned long long>(PackFile::Hash(file.data, file.size)),
+                          static_cast<unsigned long long>(PackFile::Hash(settings.data(), settings.size())));
+            return key;
+        }
+
+        void Report()
+        {
+            size_t entries = 0;
+            uintmax_t bytes = 0;
+            std::error_code error;
+            for (const std::filesystem::directory_entry &entry : std::filesystem::recursive_directory_iterator(GetDirectory(), error))
+            {
+                if (entry.is_regular_file(error))
+                    bytes += entry.file_size(error);
+                else if (entry.is_directory(error) && entry.path().parent_path() == GetDirectory())
+                    entries++;
+            }
+
+            unsigned int imports = hits + misses;
+            std::cout << "[LOG] [IMPORT_CACHE] " << hits << " hits, " << misses << " misses (" << (imports > 0 ? 100.f * hits / imports : 0.f) << "% hit rate), "
+                      << savedTime / 1000.f << " s of processing saved\n";
+            std::cout << "[LOG] [IMPORT_CACHE] " << entries << " entries, " << bytes / 1048576.f << " MB in " << GetDirectory().string() << "\n";
+        }
+
+        void Clear()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(GetDirectory(), error);
+            if (error)
+                std::cout << "[ERR] [IMPORT_CACHE_CLEAR_FAIL] " << error.message() << "\n";
+        }
+    }
+
+    namespace
+    {
+        /**
+         * @brief Writes a file unless it already holds exactly these bytes, rewriting it would trigger reloads for nothing.
+         * @return whether the file was written
+         */
+        bool WriteIfChanged(const std::filesystem::path &path, const void *data, size_t size)
+        {
+            {
+                Platform::MappedFile existing;
+                if (existing.Open(path) && existing.size == size && std::memcmp(existing.data, data, size) == 0)
+                    return false;
+            }
+
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(static_cast<const char *>(data), size);
+            if (!out)
+                std::cout << "[ERR] [IMPORT_WRITE_FAIL] [" << path.string() << "]\n";
+            return true;
+        }
+    }
+
     ModelImporter::ModelImporter(std::filesystem::path path, ContextPtr &ctx)
     {
         modelName = path.filename().replace_extension().string();
+        directory = path.parent_path();
+
+        std::string key = ImportCache::GetKey(path, GetSettings());
+        if (key.empty())
+        {
+            std::cout << "[ERR] [IMPORT] Couldn't read " << path.string() << "\n";
+            return;
+        }
+
+        std::filesystem::path entry = ImportCache::GetDirectory() / key;
+        bool hit = std::filesystem::exists(entry / "manifest.json");
+        if (hit)
+            ImportCache::hits++;
+        else
+        {
+            ImportCache::misses++;
+            if (!Process(path, entry))
+                return;
+        }
+
+        float writeTime = Write(entry, ctx);
+        if (hit)
+            ImportCache::savedTime += std::max(processTime - writeTime, 0.f);
+    }
+
+    std::string ModelImporter::GetSettings()
+    {
+        // Everything the output depends on besides the source file, outputs of older formats must not be reused
+        std::string settings = "flags " + std::to_string(postProcess) + " meshfile " + std::to_string(MeshFile::version) + " lods";
+        for (float ratio : lodRatios)
+            settings += " " + std::to_string(ratio);
+        return settings;
+    }
+
+    bool ModelImporter::Process(const std::filesystem::path &path, const std::filesystem::path &entry)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
         Assimp::Importer importer;
-        const aiScene *scene = importer.ReadFile(path.string(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+        const aiScene *scene = importer.ReadFile(path.string(), postProcess);
 
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
         {
             std::cout << "[ERR] [ASSIMP] " << importer.GetErrorString() << std::endl;
-            return;
+            return false;
         }
 
-        directory = path.parent_path();
+        // Build the entry next to its final place and move it there once complete, a cancelled import leaves no broken entry
+        entryPath = entry;
+        entryPath += ".tmp";
+        std::filesystem::remove_all(entryPath);
+        std::filesystem::create_directories(entryPath / "Meshes");
+        manifest = {{"meshes", json::array()}, {"materials", json::array()}};
+        materialIndices.clear();
+
+        ProcessNode(scene->mRootNode, scene);
+
+        manifest["source"] = path.filename().string();
+        manifest["processTime"] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::ofstream(entryPath / "manifest.json") << manifest.dump(4);
+
+        std::error_code error;
+        std::filesystem::rename(entryPath, entry, error);
+        if (error)
+        {
+            // Another editor stored the same entry meanwhile
+            std::filesystem::remove_all(entryPath, error);
+            if (!std::filesystem::exists(entry / "manifest.json"))
+            {
+                std::cout << "[ERR] [IMPORT_CACHE_WRITE_FAIL] [" << entry.string() << "]\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float ModelImporter::Write(const std::filesystem::path &entry, ContextPtr &ctx)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        json cached = json::parse(std::ifstream(entry / "manifest.json"));
+        processTime = cached.value("processTime", 0.f);
+        std::filesystem::path modelDir = directory / modelName;
+        unsigned int written = 0, unchanged = 0;
+
+        std::vector<RID> materialRIDs;
+        for (const json &cachedMaterial : cached["materials"])
+        {
+            Material material = cachedMaterial["material"];
+            std::filesystem::path texturePath = directory / cachedMaterial["texture"].get<std::string>();
+            material.texture.rid = ctx.resourceManager->GetRID(texturePath);
+            if (std::filesystem::exists(texturePath) && TextureCompressor::IsStale(texturePath))
+                TextureCompressor::CompressImage(texturePath);
+            material.shader.rid = ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Shaders" / "Default.glsl");
+
+            std::filesystem::path materialPath = modelDir / cachedMaterial["file"].get<std::string>();
+            std::filesystem::create_directories(materialPath.parent_path());
+            std::string data = json(material).dump();
+            WriteIfChanged(materialPath, data.data(), data.size()) ? written++ : unchanged++;
+
+            materialRIDs.push_back(ctx.resourceManager->GetRID(materialPath));
+        }
+
+        for (const json &cachedMesh : cached["meshes"])
+        {
+            std::filesystem::path cachedPath = entry / cachedMesh["file"].get<std::string>();
+            std::ifstream in(cachedPath, std::ios::binary);
+            std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+            // The entry refers to materials by index, point the mesh at this project's RIDs
+            MeshFile::Header header;
+            bool valid = data.size() >= sizeof(header) && MeshFile::IsMeshFile(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+            if (valid)
+            {
+                std::memcpy(&header, data.data(), sizeof(header));
+                valid = header.materialOffset + uint64_t(header.materialCount) * sizeof(RID) <= data.size();
+            }
+            if (!valid)
+            {
+                std::cout << "[ERR] [IMPORT_CACHE_CORRUPT] [" << cachedPath.string() << "]\n";
+                continue;
+            }
+            for (uint32_t i = 0; i < header.materialCount; i++)
+            {
+                RID index;
+                std::memcpy(&index, data.data() + header.materialOffset + i * sizeof(RID), sizeof(RID));
+                RID rid = index < materialRIDs.size() ? materialRIDs[index] : 0;
+                std::memcpy(data.data() + header.materialOffset + i * sizeof(RID), &rid, sizeof(RID));
+            }
+
+            std::filesystem::create_directories(modelDir);
+            WriteIfChanged(modelDir / cachedMesh["name"].get<std::string>(), data.data(), data.size()) ? written++ : unchanged++;
+        }
 
-        ProcessNode(scene->mRootNode, scene, ctx);
+        float writeTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[LOG] [IMPORT] " << modelName << ": " << written << " files written, " << unchanged << " unchanged in " << writeTime << " ms\n";
+        return writeTime;
     }
 
-    void ModelImporter::ProcessNode(aiNode *node, const aiScene *scene, ContextPtr &ctx)
+    void ModelImporter::ProcessNode(aiNode *node, const aiScene *scene)
     {
         for (unsigned int i = 0; i < node->mNumMeshes; i++)
-            ProcessMesh(scene->mMeshes[node->mMeshes[i]], scene, ctx);
+            ProcessMesh(scene->mMeshes[node->mMeshes[i]], scene);
 
         for (unsigned int i = 0; i < node->mNumChildren; i++)
-            ProcessNode(node->mChildren[i], scene, ctx);
+            ProcessNode(node->mChildren[i], scene);
     }
 
-    void ModelImporter::ProcessMesh(aiMesh *mesh, const aiScene *scene, ContextPtr &ctx)
+    void ModelImporter::ProcessMesh(aiMesh *mesh, const aiScene *scene)
     {
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
@@ -184,44 +379,108 @@ namespace DT
             vertices.push_back(vertex);
         }
 
+        // Each bone influence goes into the first free slot of the vertex, extra influences are dropped
+        for (unsigned int i = 0; i < mesh->mNumBones; i++)
+        {
+            aiBone *bone = mesh->mBones[i];
+            for (unsigned int j = 0; j < bone->mNumWeights; j++)
+            {
+                Vertex &vertex = vertices[bone->mWeights[j].mVertexId];
+                for (int k = 0; k < MAX_BONE_INFLUENCE; k++)
+                {
+                    if (vertex.weights[k] == 0.f)
+                    {
+                        vertex.boneIDs[k] = i;
+                        vertex.weights[k] = bone->mWeights[j].mWeight;
+                        break;
+                    }
+                }
+            }
+        }
+
         for (unsigned int i = 0; i < mesh->mNumFaces; i++)
         {
+            // Points and lines survive triangulation, they can't be drawn as triangles
             aiFace face = mesh->mFaces[i];
+            if (face.mNumIndices != 3)
+                continue;
             for (unsigned int j = 0; j < face.mNumIndices; j++)
                 indices.push_back(face.mIndices[j]);
         }
 
+        MeshOptimizer::CacheStats before = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+        size_t importedVertices = vertices.size();
+
+        MeshOptimizer::DeduplicateVertices(vertices, indices);
+        MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+        MeshOptimizer::OptimizeOverdraw(indices, vertices);
+
+        MeshOptimizer::CacheStats after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+        std::cout << "[LOG] [IMPORT] " << mesh->mName.C_Str() << ": " << importedVertices << " -> " << vertices.size() << " vertices, ACMR "
+                  << before.acmr << " -> " << after.acmr << ", ATVR " << before.atvr << " -> " << after.atvr << "\n";
+
+        // LODs share the vertices, their indices follow the full mesh's in the same index buffer
+        std::vector<MeshLOD> lods = {{0, static_cast<uint32_t>(indices.size()), 0.f}};
+        size_t fullIndexCount = indices.size();
+        std::vector<unsigned int> previousLOD = indices;
+        for (float ratio : lodRatios)
+        {
+            // Each LOD is simplified from the previous one, its error adds up with theirs
+            size_t target = static_cast<size_t>(fullIndexCount * ratio) / 3 * 3;
+            float error = 0.f;
+            std::vector<unsigned int> lodIndices = MeshOptimizer::Simplify(vertices, previousLOD, target, error);
+
+            // Stop once simplification stalls, another LOD that barely differs would only cost memory
+            if (lodIndices.empty() || lodIndices.size() > lods.back().indexCount * 0.9f)
+                break;
+
+            MeshOptimizer::OptimizeVertexCache(lodIndices, vertices.size());
+            previousLOD = lodIndices;
+            lods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lodIndices.size()), lods.back().error + error});
+            indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+            std::cout << "[LOG] [IMPORT] " << mesh->mName.C_Str() << " LOD" << lods.size() - 1 << ": " << lodIndices.size() / 3 << " triangles, error " << error << "\n";
+        }
+
+        MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+
         aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
 
-        std::vector<RID> materials;
-        std::vector<RID> diffuseMaps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "diffuse", Texture::Type::DIFFUSE, ctx);
+        std::vector<uint32_t> materials;
+        std::vector<uint32_t> diffuseMaps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "diffuse", Texture::Type::DIFFUSE);
         materials.insert(materials.end(), diffuseMaps.begin(), diffuseMaps.end());
-        std::vector<RID> specularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "specular", Texture::Type::SPECULAR, ctx);
+        std::vector<uint32_t> specularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "specular", Texture::Type::SPECULAR);
         materials.insert(materials.end(), specularMaps.begin(), specularMaps.end());
-        std::vector<RID> normalMaps = LoadMaterialTextures(material, aiTextureType_HEIGHT, "normal", Texture::Type::NORMAL, ctx);
+        std::vector<uint32_t> normalMaps = LoadMaterialTextures(material, aiTextureType_HEIGHT, "normal", Texture::Type::NORMAL);
         materials.insert(materials.end(), normalMaps.begin(), normalMaps.end());
-        std::vector<RID> heightMaps = LoadMaterialTextures(material, aiTextureType_AMBIENT, "height", Texture::Type::HEIGHT, ctx);
+        std::vector<uint32_t> heightMaps = LoadMaterialTextures(material, aiTextureType_AMBIENT, "height", Texture::Type::HEIGHT);
         materials.insert(materials.end(), heightMaps.begin(), heightMaps.end());
 
-        std::filesystem::path modelDir = directory / modelName;
         std::filesystem::path meshFileName = std::filesystem::path(std::string(mesh->mName.C_Str()) + ".dtmesh");
-
-        std::filesystem::create_directories(modelDir);
+        std::string cachedFileName = "Meshes/" + std::to_string(manifest["meshes"].size()) + ".dtmesh";
 
         Mesh resultMesh;
         resultMesh.vertices = vertices;
         resultMesh.indices = indices;
+        if (lods.size() > 1)
+            resultMesh.lods = lods;
+        // Stored as indices into the entry's materials, Write swaps in the RIDs of the project
         resultMesh.materials.resize(materials.size());
         for (int i = 0; i < materials.size(); i++)
             resultMesh.materials[i].rid = materials[i];
+        resultMesh.ComputeBounds();
+        resultMesh.ChooseLayout();
 
-        std::ofstream out(modelDir / meshFileName);
-        out << json(resultMesh);
+        if (resultMesh.WriteBinary(entryPath / cachedFileName))
+        {
+            manifest["meshes"].push_back({{"name", meshFileName.string()}, {"file", cachedFileName}});
+            std::cout << "[LOG] [IMPORT] " << meshFileName.string() << ": " << (resultMesh.layout == VertexLayout::Compact ? "compact" : "standard")
+                      << (resultMesh.skinned ? " skinned" : "") << " layout, " << MeshFile::VertexStride(resultMesh.layout) << " bytes per vertex\n";
+        }
     }
 
-    std::vector<RID> ModelImporter::LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName, Texture::Type textureType, ContextPtr &ctx)
+    std::vector<uint32_t> ModelImporter::LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName, Texture::Type textureType)
     {
-        std::vector<RID> materialRIDs;
+        std::vector<uint32_t> indices;
         std::string materialName = mat->GetName().C_Str();
 
         for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
@@ -230,6 +489,15 @@ namespace DT
             mat->GetTexture(type, i, &str);
             std::string textureName(str.C_Str());
 
+            std::string materialFileName = "Materials/" + materialName + "-" + typeName + ".dtmaterial";
+            auto known = materialIndices.find(materialFileName);
+            if (known != materialIndices.end())
+            {
+                indices.push_back(known->second);
+                continue;
+            }
+
+            // Texture and shader are project RIDs, the entry keeps the texture path and Write resolves both
             Material material;
             aiColor3D color(1.f, 1.f, 1.f);
             mat->Get(AI_MATKEY_COLOR_DIFFUSE, color);
@@ -238,26 +506,20 @@ namespace DT
             material.specularColor = {color.r, color.g, color.b};
             mat->Get(AI_MATKEY_COLOR_AMBIENT, color);
             material.ambientColor = {color.r, color.g, color.b};
-            material.texture.rid = ctx.resourceManager->GetRID(directory / textureName);
-            material.shader.rid = ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Shaders" / "Default.glsl");
             material.textureType = textureType;
 
-            std::filesystem::path modelDir = directory / modelName;
-            std::string materialFileName = materialName + "-" + typeName + ".dtmaterial";
-
-            std::filesystem::create_directories(modelDir / "Materials");
-            std::ofstream out(modelDir / "Materials" / materialFileName);
-            out << json(material);
-
-            materialRIDs.push_back(ctx.resourceManager->GetRID(modelDir / "Materials" / materialFileName));
+            uint32_t index = static_cast<uint32_t>(manifest["materials"].size());
+            manifest["materials"].push_back({{"file", materialFileName}, {"texture", textureName}, {"material", json(material)}});
+            materialIndices.emplace(materialFileName, index);
+            indices.push_back(index);
         }
 
-        return materialRIDs;
+        return indices;
     }
 
     void ModelInterface::Init(ContextPtr &ctx)
     {
-        iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "model.png"), ctx)->id;
+        iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "model.png"), ctx)->id;
     }
 
     void ModelInterface::Inspect(ContextPtr &ctx)
@@ -266,6 +528,20 @@ namespace DT
         ImGui::TextDisabled("Model");
 
         ImGui::Separator();
+
+        if (ImGui::CollapsingHeader("LODs"))
+        {
+            for (size_t i = 0; i < ModelImporter::lodRatios.size(); i++)
+            {
+                std::string label = "LOD" + std::to_string(i + 1) + " ratio";
+                ImGui::SliderFloat(label.c_str(), &ModelImporter::lodRatios[i], 0.01f, 1.f);
+            }
+            if (ImGui::Button("Add LOD"))
+                ModelImporter::lodRatios.push_back(ModelImporter::lodRatios.empty() ? 0.5f : ModelImporter::lodRatios.back() * 0.5f);
+            ImGui::SameLine();
+            if (ImGui::Button("Remove LOD") && !ModelImporter::lodRatios.empty())
+                ModelImporter::lodRatios.pop_back();
+        }
     }
 
     void ModelInterface::OpenInspect(RID rid, ContextPtr& ctx)
@@ -280,7 +556,7 @@ namespace DT
 
     void MarkdownInterface::Init(ContextPtr &ctx)
     {
-        iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "markdown.png"), ctx)->id;
+        iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "markdown.png"), ctx)->id;
     }
 
     void MarkdownInterface::OpenInspect(RID rid, ContextPtr& ctx)
@@ -321,10 +597,255 @@ namespace DT
         if (interface != nullptr)
             iconId = interface->iconId;
         if (iconId == 0)
-            iconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "file.png"), ctx)->id;
+            iconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "ResourceBrowser" / "file.png"), ctx)->id;
         return iconId;
     }
 
+    void ResourceInterface::ConvertMeshes(ContextPtr &ctx)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        unsigned int converted = 0;
+        double jsonLoadTime = 0.0, binaryLoadTime = 0.0;
+        uintmax_t jsonSize = 0, binarySize = 0;
+
+        for (auto &[rid, path] : ctx.resourceManager->resourceMap)
+        {
+            if (path.extension() != ".dtmesh" || !std::filesystem::exists(path) || MeshFile::IsMeshFile(path))
+                continue;
+
+            try
+            {
+                Clock::time_point start = Clock::now();
+                Mesh mesh = json::parse(std::ifstream(path));
+                mesh.ComputeBounds();
+                mesh.ChooseLayout();
+                jsonLoadTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                jsonSize += std::filesystem::file_size(path);
+
+                // Written next to the original first so that a failed write never loses the mesh
+                std::filesystem::path binaryPath = path;
+                binaryPath += ".tmp";
+                if (!mesh.WriteBinary(binaryPath))
+                    continue;
+                std::filesystem::rename(binaryPath, path);
+
+                start = Clock::now();
+                Mesh *binaryMesh = Mesh::LoadBinary(path);
+                binaryLoadTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                binarySize += std::filesystem::file_size(path);
+                delete binaryMesh;
+
+                converted++;
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << "[ERR] [MESH_CONVERT_FAIL] [" << path.string() << "] " << e.what() << std::endl;
+            }
+        }
+
+        std::cout << "[LOG] Converted " << converted << " meshes to binary. JSON: " << jsonLoadTime << " ms, " << jsonSize << " bytes. Binary: " << binaryLoadTime << " ms, " << binarySize << " bytes.\n";
+    }
+
+    void ResourceInterface::BenchmarkResourceManager(unsigned int resourceCount)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto elapsed = [](Clock::time_point start)
+        { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+        ResourceManager resourceManager;
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(resourceCount);
+        for (unsigned int i = 0; i < resourceCount; i++)
+            paths.push_back(std::filesystem::path("Benchmark") / ("Model" + std::to_string(i / 64)) / ("Mesh" + std::to_string(i) + ".dtmesh"));
+
+        Clock::time_point start = Clock::now();
+        for (const std::filesystem::path &path : paths)
+            resourceManager.GetRID(path);
+        double registerTime = elapsed(start);
+
+        start = Clock::now();
+        RID checksum = 0;
+        for (const std::filesystem::path &path : paths)
+            checksum += resourceManager.GetRID(path);
+        for (RID rid = 1; rid <= resourceCount; rid++)
+            checksum += static_cast<RID>(resourceManager.GetPath(rid).native().size());
+        double lookupTime = elapsed(start);
+
+        start = Clock::now();
+        for (RID rid = 1; rid <= resourceCount; rid += 2)
+            resourceManager.ReleaseRID(rid);
+        for (unsigned int i = 0; i < resourceCount; i += 2)
+            resourceManager.GetRID(paths[i]);
+        double reuseTime = elapsed(start);
+
+        std::cout << "[LOG] ResourceManager benchmark, " << resourceCount << " resources: register " << registerTime << " ms, lookup both ways "
+                  << lookupTime << " ms, release and re-register half " << reuseTime << " ms (checksum " << checksum << ")\n";
+    }
+
+    void ResourceInterface::BuildPack(ContextPtr &ctx, PackFile::Compression compression)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto elapsed = [](Clock::time_point start)
+        { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+        std::filesystem::path root = ctx.ctx->ctxPath.parent_path();
+        // Kept out of the project directory, a pack next to the project file would shadow the files being edited
+        std::filesystem::path packPath = root / "Build" / PackFile::fileName;
+        std::error_code error;
+        std::filesystem::create_directories(packPath.parent_path(), error);
+        if (!PackFile::Build(*ctx.resourceManager, root, packPath, compression))
+            return;
+
+        PackArchive archive;
+        if (!archive.Open(packPath))
+            return;
+
+        // Touch every byte so both sides pay for the actual reads, not just the mapping
+        auto sum = [](const unsigned char *data, size_t size)
+        {
+            uint64_t checksum = 0;
+            for (size_t i = 0; i < size; i++)
+                checksum += data[i];
+            return checksum;
+        };
+
+        uint64_t looseChecksum = 0, packedChecksum = 0;
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < archive.GetEntryCount(); i++)
+        {
+            Platform::MappedFile file;
+            if (file.Open(root / archive.GetPath(archive.GetEntry(i))))
+                looseChecksum += sum(file.data, file.size);
+        }
+        double looseTime = elapsed(start);
+
+        start = Clock::now();
+        for (uint32_t i = 0; i < archive.GetEntryCount(); i++)
+        {
+            FileView file = archive.Read(archive.GetEntry(i));
+            packedChecksum += sum(file.data, file.size);
+        }
+        double packedTime = elapsed(start);
+
+        std::cout << "[LOG] Read " << archive.GetEntryCount() << " files loose in " << looseTime << " ms, packed in " << packedTime << " ms"
+                  << (looseChecksum == packedChecksum ? "" : " (contents differ, the pack is broken)") << "\n";
+    }
+
+    void ResourceInterface::BenchmarkCompression(ContextPtr &ctx, float diskSpeed)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto elapsed = [](Clock::time_point start)
+        { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+        std::vector<std::vector<char>> files;
+        uint64_t rawSize = 0;
+        for (auto &[rid, path] : ctx.resourceManager->resourceMap)
+        {
+            std::error_code error;
+            if (!std::filesystem::is_regular_file(path, error))
+                continue;
+
+            std::ifstream in(path, std::ios::binary);
+            files.emplace_back((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            rawSize += files.back().size();
+        }
+        if (rawSize == 0)
+            return;
+
+        for (PackFile::Compression compression : {PackFile::Compression::None, PackFile::Compression::LZ4, PackFile::Compression::LZ4High})
+        {
+            std::vector<std::vector<unsigned char>> blobs(files.size());
+            uint64_t storedSize = 0;
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < files.size(); i++)
+            {
+                if (compression == PackFile::Compression::None)
+                    blobs[i].assign(files[i].begin(), files[i].end());
+                else
+                    blobs[i] = PackFile::CompressBlob(files[i].data(), files[i].size(), compression);
+                storedSize += blobs[i].size();
+            }
+            double compressTime = elapsed(start);
+
+            std::vector<unsigned char> destination;
+            start = Clock::now();
+            for (size_t i = 0; i < files.size(); i++)
+            {
+                PackFile::Entry entry = {};
+                entry.compression = static_cast<uint32_t>(compression);
+                entry.size = blobs[i].size();
+                entry.rawSize = files[i].size();
+                destination.resize(files[i].size());
+                PackStream(blobs[i].data(), entry).Read(destination.data(), destination.size());
+            }
+            double decompressTime = elapsed(start);
+
+            const char *names[] = {"raw", "LZ4", "LZ4 high"};
+            double readTime = storedSize / (diskSpeed * 1048576.0) * 1000.0;
+            std::cout << "[LOG] " << names[static_cast<uint32_t>(compression)] << ": " << rawSize / 1048576.f << " MB -> " << storedSize / 1048576.f
+                      << " MB (ratio " << (double)rawSize / storedSize << "), compress " << rawSize / 1048.576 / compressTime << " MB/s, decompress "
+                      << rawSize / 1048.576 / decompressTime << " MB/s, load latency at " << diskSpeed << " MB/s " << readTime + decompressTime << " ms\n";
+        }
+    }
+
+    void ResourceInterface::CompressTextures(ContextPtr &ctx)
+    {
+        using Clock = std::chrono::steady_clock;
+        auto elapsed = [](Clock::time_point start)
+        { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+        unsigned int compressed = 0, upToDate = 0;
+        double compressTime = 0.0, decodeTime = 0.0, mapTime = 0.0;
+        size_t rawSize = 0, blockSize = 0;
+
+        for (auto &[rid, path] : ctx.resourceManager->resourceMap)
+        {
+            std::string extension = path.extension().string();
+            if ((extension != ".png" && extension != ".jpg" && extension != ".jpeg") || !std::filesystem::exists(path))
+                continue;
+
+            if (TextureCompressor::IsStale(path))
+            {
+                Clock::time_point start = Clock::now();
+                if (!TextureCompressor::CompressImage(path))
+                    continue;
+                compressTime += elapsed(start);
+                compressed++;
+
+                // Swap the copy in for anyone showing the texture right now
+                if (ResourceCache::Find<Texture>(rid))
+                    ctx.resourceLoader->Reload<Texture>(rid, ctx);
+            }
+            else
+                upToDate++;
+
+            // What loading costs either way, without the GL upload
+            Texture texture;
+            texture.texturePath = path;
+            Clock::time_point start = Clock::now();
+            if (!texture.OpenCompressed())
+                continue;
+            mapTime += elapsed(start);
+            blockSize += texture.compressed.size;
+
+            start = Clock::now();
+            int width, height, channels;
+            stbi_set_flip_vertically_on_load_thread(true);
+            if (unsigned char *pixels = stbi_load(path.string().c_str(), &width, &height, &channels, 0))
+            {
+                decodeTime += elapsed(start);
+                // Drivers pad RGB to RGBA, the mip chain adds a third
+                rawSize += (size_t)width * height * (channels == 3 ? 4 : channels) * 4 / 3;
+                stbi_image_free(pixels);
+            }
+        }
+
+        std::cout << "[LOG] Compressed " << compressed << " textures in " << compressTime << " ms, " << upToDate << " were up to date.\n";
+        std::cout << "[LOG] Decode and mipmap: " << decodeTime << " ms, " << rawSize / 1048576.f << " MB video memory. Block compressed: "
+                  << mapTime << " ms, " << blockSize / 1048576.f << " MB video memory.\n";
+    }
+
     void ResourceInterface::AddDefault(ContextPtr &ctx)
     {
         RegisterInterface<MaterialInterface>({".mtl", ".dtmaterial"}, ctx);
@@ -5,6 +5,9 @@
 #include <vector>
 #include <filesystem>
 #include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -18,8 +21,13 @@ using json = nlohmann::json;
 #include <Core/Resource.h>
 #include <Core/ImGui.h>
 #include <Renderer/Mesh.h>
+#include <Renderer/MeshOptimizer.h>
+#include <Renderer/TextureCompressor.h>
 #include <Scene/Entity.h>
 #include <Core/ResourceManager.h>
+#include <Core/PackFile.h>
+#include <Core/Platform.h>
+#include <Core/Context.h>
 
 namespace DT
 {
@@ -53,6 +61,33 @@ namespace DT
         bool HasInterface(const std::string &extension);
         void AddDefault(ContextPtr &ctx);
 
+        /**
+         * @brief Rewrites every JSON .dtmesh of the project in the binary MeshFile format and logs the load times of both formats.
+         */
+        void ConvertMeshes(ContextPtr &ctx);
+
+        /**
+         * @brief Registers, looks up, releases and re-registers resourceCount paths in a scratch ResourceManager and logs the timings.
+         */
+        void BenchmarkResourceManager(unsigned int resourceCount = 100000);
+
+        /**
+         * @brief Packs the project's resources into Build/PackFile::fileName and logs how long reading them takes loose and packed.
+         */
+        void BuildPack(ContextPtr &ctx, PackFile::Compression compression = PackFile::Compression::LZ4);
+
+        /**
+         * @brief Compresses every project file without, with fast and with high LZ4 compression and logs the ratio, the
+         * compression and decompression throughput and the load latency each would have on a disk reading diskSpeed MB/s.
+         */
+        void BenchmarkCompression(ContextPtr &ctx, float diskSpeed = 100.f);
+
+        /**
+         * @brief Block compresses every image of the project whose compressed copy is missing or stale and logs the
+         * load time and video memory of the images decoded against their compressed copies.
+         */
+        void CompressTextures(ContextPtr &ctx);
+
         unsigned int GetIcon(const std::string &extension, ContextPtr &ctx);
     }
 
@@ -95,17 +130,77 @@ namespace DT
         void CloseInspect(ContextPtr &ctx) override;
     };
 
+    /**
+     * @brief Content addressed cache of processed model imports, shared by every project on the machine.
+     *
+     * An entry is keyed by a hash of the source file and of the importer settings. It holds the meshes in the MeshFile
+     * format, with indices into the entry's materials in place of material RIDs, and the materials with the path of
+     * their texture, so the same entry can be written into any project.
+     */
+    namespace ImportCache
+    {
+        inline unsigned int hits = 0;   /// @brief Imports served from the cache this session.
+        inline unsigned int misses = 0; /// @brief Imports processed from scratch this session.
+        inline float savedTime = 0.f;   /// @brief Milliseconds of processing skipped by cache hits this session.
+
+        std::filesystem::path GetDirectory();
+
+        /**
+         * @brief Hashes a source file together with the settings that were used to process it.
+         * @return The key of the entry, empty if the source can't be read.
+         */
+        std::string GetKey(const std::filesystem::path &source, const std::string &settings);
+
+        /**
+         * @brief Logs the hits and misses of this session and the size of the cache on disk.
+         */
+        void Report();
+
+        /**
+         * @brief Deletes every entry, the next import of each model processes it again.
+         */
+        void Clear();
+    }
+
     class ModelImporter
     {
     public:
         std::filesystem::path directory;
         std::string modelName;
+        static inline std::vector<float> lodRatios = {0.5f, 0.25f, 0.125f}; /// @brief triangle ratio of each generated LOD to the full mesh
 
+        /**
+         * @brief Imports a model into the directory next to it, processing it only if the import cache has no entry for it.
+         */
         ModelImporter(std::filesystem::path path, ContextPtr &ctx);
 
-        void ProcessNode(aiNode *node, const aiScene *scene, ContextPtr &ctx);
-        void ProcessMesh(aiMesh *mesh, const aiScene *scene, ContextPtr &ctx);
-        std::vector<RID> LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName, Texture::Type textureType, ContextPtr &ctx);
+        /**
+         * @brief Describes every setting that changes the processed output, part of the import cache key.
+         */
+        static std::string GetSettings();
+
+        /**
+         * @brief Runs Assimp and the mesh optimizer over a model and stores the result as an import cache entry.
+         * @return whether the entry was written
+         */
+        bool Process(const std::filesystem::path &path, const std::filesystem::path &entry);
+        void ProcessNode(aiNode *node, const aiScene *scene);
+        void ProcessMesh(aiMesh *mesh, const aiScene *scene);
+        std::vector<uint32_t> LoadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName, Texture::Type textureType);
+
+        /**
+         * @brief Writes the meshes and materials of an import cache entry into the project, files whose content didn't change are left untouched.
+         * @return milliseconds spent writing
+         */
+        float Write(const std::filesystem::path &entry, ContextPtr &ctx);
+
+    private:
+        static constexpr unsigned int postProcess = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+
+        float processTime = 0.f;                                 /// @brief Milliseconds it took to process the entry last written by Write.
+        std::filesystem::path entryPath;                         /// @brief Entry being written by Process.
+        json manifest;                                           /// @brief Meshes and materials of the entry being written by Process.
+        std::unordered_map<std::string, uint32_t> materialIndices; /// @brief Index in manifest of every material file, meshes share their materials.
     };
 
     class ModelInterface : public Interface
@@ -57,12 +57,11 @@ namespace DT
         if (ctx.sceneManager->GetActiveScene().Has<Relation>(entity))
         {
             Relation &relation = *ctx.sceneManager->GetActiveScene().Get<Relation>(entity);
-            for (Entity child : relation.children)
-            {
-                ImGui::Indent();
-                DrawSelectibleEntity(child, ctx);
-                ImGui::Unindent();
-            }
+            relation.ForEachChild(ctx.sceneManager->GetActiveScene().registry, [&](Entity child)
+                                  {
+                                      ImGui::Indent();
+                                      DrawSelectibleEntity(child, ctx);
+                                      ImGui::Unindent(); });
         }
     }
 }
\ No newline at end of file
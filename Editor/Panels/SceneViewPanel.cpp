@@ -4,13 +4,13 @@ namespace DT
 {
     void SceneViewPanel::Start(ContextPtr &ctx)
     {
-        translateIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "translate.png"), ctx)->id;
-        rotateIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "rotate.png"), ctx)->id;
-        scaleIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "scale.png"), ctx)->id;
+        translateIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "translate.png"), ctx)->id;
+        rotateIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "rotate.png"), ctx)->id;
+        scaleIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "SceneView" / "scale.png"), ctx)->id;
 
-        playIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "start.png"), ctx)->id;
-        pauseIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "pause.png"), ctx)->id;
-        stopIconId = Texture::LoadResource(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "stop.png"), ctx)->id;
+        playIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "start.png"), ctx)->id;
+        pauseIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "pause.png"), ctx)->id;
+        stopIconId = ResourceCache::Load<Texture>(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Icons" / "MenuBar" / "stop.png"), ctx)->id;
 
         ctx.input->OnKeyEvent([&](Key key, Action action)
                               {
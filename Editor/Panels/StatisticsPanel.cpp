@@ -0,0 +1,95 @@
+#include <algorithm>
+
+#include <Core/HotReloader.h>
+#include <Core/JobSystem.h>
+#include <Panels/StatisticsPanel.h>
+
+namespace DT
+{
+	void StatisticsPanel::Update(ContextPtr &ctx)
+	{
+		ImGui::Begin(GetWindowName().c_str(), &isOpen);
+
+		ImGui::Text("fps: %.1f", ctx.time->fps);
+
+		if (ImGui::CollapsingHeader("Renderer", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			const RenderStats &stats = ctx.renderer->stats;
+			ImGui::Checkbox("frustum culling", &ctx.renderer->frustumCulling);
+			ImGui::SliderFloat("LOD error (px)", &ctx.renderer->lodErrorThreshold, 0.f, 16.f);
+			ImGui::Text("instances: %u", stats.instances);
+			ImGui::Text("visible instances: %u", stats.visibleInstances);
+			ImGui::Text("culled instances: %u", stats.culledInstances);
+			ImGui::Text("batches: %u", stats.batches);
+			ImGui::Text("draw calls: %u", stats.drawCalls);
+			ImGui::Text("triangles: %u", stats.triangles);
+			ImGui::Text("reduced LOD instances: %u", stats.reducedLODInstances);
+			ImGui::Text("state changes: %u", stats.stateChanges);
+			ImGui::Text("skipped state changes: %u", stats.skippedStateChanges);
+			ImGui::Text("lights: %u", stats.lights);
+			ImGui::Text("culled point lights: %u", stats.culledLights);
+			ImGui::Text("cluster light assignments: %u", stats.lightAssignments);
+		}
+
+		if (ImGui::CollapsingHeader("Systems", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Checkbox("parallel systems", &ctx.engine->scheduler.parallel);
+			ImGui::Text("systems: %zu in %u batches", ctx.sceneManager->GetActiveScene().systems.size(), ctx.engine->scheduler.GetBatchCount());
+			ImGui::Text("job workers: %u", ctx.jobSystem->GetWorkerCount());
+		}
+
+		if (ImGui::CollapsingHeader("Resources", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Text("pending loads: %u", ctx.resourceLoader->GetPendingLoads());
+			ImGui::SliderFloat("upload budget (ms)", &ctx.resourceLoader->uploadBudget, 0.f, 16.f);
+			ImGui::Text("cached resources: %zu (%zu evictable)", ResourceCache::GetEntryCount(), ResourceCache::GetEvictableCount());
+			ImGui::Text("CPU memory: %.1f / %.1f MB", ResourceCache::GetCPUUsage() / 1048576.f, ResourceCache::cpuBudget / 1048576.f);
+			ImGui::Text("GPU memory: %.1f / %.1f MB", ResourceCache::GetGPUUsage() / 1048576.f, ResourceCache::gpuBudget / 1048576.f);
+			ImGui::Text("evictions: %u", ResourceCache::GetEvictionCount());
+			ImGui::Checkbox("hot reload", &ctx.hotReloader->enabled);
+			ImGui::SameLine();
+			ImGui::Text("%zu files watched, %u reloads", ctx.hotReloader->GetWatchedCount(), ctx.hotReloader->GetReloadCount());
+			ImGui::SliderFloat("reload debounce (ms)", &ctx.hotReloader->debounce, 0.f, 1000.f);
+
+			if (ImGui::TreeNode("Cache entries"))
+			{
+				std::vector<ResourceCache::EntryInfo> entries = ResourceCache::GetEntries();
+				std::sort(entries.begin(), entries.end(), [](const ResourceCache::EntryInfo &a, const ResourceCache::EntryInfo &b)
+						  { return a.cpu + a.gpu > b.cpu + b.gpu; });
+
+				if (ImGui::BeginTable("Cache entries", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, ImVec2(0.f, 300.f)))
+				{
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("type");
+					ImGui::TableSetupColumn("path");
+					ImGui::TableSetupColumn("refs");
+					ImGui::TableSetupColumn("CPU (KB)");
+					ImGui::TableSetupColumn("GPU (KB)");
+					ImGui::TableSetupColumn("load (ms)");
+					ImGui::TableHeadersRow();
+
+					for (const ResourceCache::EntryInfo &entry : entries)
+					{
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(entry.typeName);
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(ctx.resourceManager->GetPath(entry.rid).filename().string().c_str());
+						ImGui::TableNextColumn();
+						ImGui::Text(entry.evictable ? "%u (evictable)" : "%u", entry.refs);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.1f", entry.cpu / 1024.f);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.1f", entry.gpu / 1024.f);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.2f", entry.loadTime);
+					}
+					ImGui::EndTable();
+				}
+				ImGui::TreePop();
+			}
+		}
+
+		ImGui::End();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Panels/Panel.h>
+
+namespace DT
+{
+	class StatisticsPanel : public Panel
+	{
+	public:
+		inline std::string GetWindowName() override { return "Statistics"; }
+
+		void Update(ContextPtr &ctx) override;
+	};
+}
\ No newline at end of file
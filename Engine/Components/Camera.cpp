@@ -39,39 +39,73 @@ namespace DT
         return windowSpacePos;
     }
 
+    CameraSystem::CameraSystem()
+    {
+        // Registered after the TransformSystem, reading what it writes keeps it ticking after the propagation
+        access.Read<Transform, WorldTransform>().Write<Camera>().AnyThread();
+    }
+
     void CameraSystem::Init(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<Camera>())
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        for (auto [entity, cam] : scene.View<Camera>().each())
         {
-            Camera *cam = ctx.sceneManager->GetActiveScene().Get<Camera>(entity);
+            scene.activeCamera = &cam;
 
-            ctx.sceneManager->GetActiveScene().activeCamera = cam;
+            cam.transform = scene.Get<Transform>(entity);
 
-            cam->transform = ctx.sceneManager->GetActiveScene().Get<Transform>(entity);
-
-            ctx.renderer->cameraView = &cam->view;
-            ctx.renderer->cameraProjection = &cam->projection;
-            ctx.renderer->cameraPosition = &cam->transform->translation;
-            ctx.renderer->cameraRotation = &cam->transform->rotation;
-            ctx.renderer->isOrtho = &cam->isOrtho;
-            ctx.renderer->fov = &cam->fov;
+            ctx.renderer->cameraView = &cam.view;
+            ctx.renderer->cameraProjection = &cam.projection;
+            ctx.renderer->cameraPosition = &cam.position;
+            ctx.renderer->cameraRotation = &cam.rotation;
+            ctx.renderer->isOrtho = &cam.isOrtho;
+            ctx.renderer->fov = &cam.fov;
         }
+        UpdatePose(scene);
     }
 
-    void CameraSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
+    void CameraSystem::Tick(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<Camera>())
-        {
-            if (selectedEntity != entity)
-                continue;
+        UpdatePose(ctx.sceneManager->GetActiveScene());
+    }
 
-            Camera *cam = ctx.sceneManager->GetActiveScene().Get<Camera>(entity);
+    void CameraSystem::SceneView(ContextPtr &ctx)
+    {
+        UpdatePose(ctx.sceneManager->GetActiveScene());
+    }
 
-            if (ImGui::CollapsingHeader("Camera"))
+    void CameraSystem::UpdatePose(Scene &scene)
+    {
+        auto worlds = scene.View<WorldTransform>();
+        for (auto [entity, cam] : scene.View<Camera>().each())
+        {
+            if (worlds.contains(entity))
             {
-                ImGui::Checkbox("orthographic", &cam->isOrtho);
-                ImGui::DragFloat("field of view", &cam->fov);
+                // Scale is taken out of the basis before it is read as a rotation
+                const glm::mat4 &world = worlds.get<WorldTransform>(entity).world;
+                cam.position = glm::vec3(world[3]);
+                cam.rotation = glm::normalize(glm::quat_cast(glm::mat3(glm::normalize(glm::vec3(world[0])), glm::normalize(glm::vec3(world[1])), glm::normalize(glm::vec3(world[2])))));
             }
+            else if (cam.transform != nullptr)
+            {
+                cam.position = cam.transform->translation;
+                cam.rotation = cam.transform->rotation;
+            }
+        }
+    }
+
+    void CameraSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
+    {
+        auto view = ctx.sceneManager->GetActiveScene().View<Camera>();
+        if (!view.contains(selectedEntity))
+            return;
+
+        Camera &cam = view.get<Camera>(selectedEntity);
+
+        if (ImGui::CollapsingHeader("Camera"))
+        {
+            ImGui::Checkbox("orthographic", &cam.isOrtho);
+            ImGui::DragFloat("field of view", &cam.fov);
         }
     }
 
@@ -39,6 +39,9 @@ namespace DT
 
         Transform *transform;
 
+        glm::vec3 position = glm::vec3(0.f);                /// @brief World space position, follows the parents of the Transform.
+        glm::quat rotation = glm::quat(1.f, 0.f, 0.f, 0.f); /// @brief World space rotation, follows the parents of the Transform.
+
         /**
          * @brief Function to convert a 3D world point into a 2D point on the screen after projection.
          * @param worldPoint 3D vector for which projection has to be done.
@@ -53,8 +56,17 @@ namespace DT
     class CameraSystem : public System
     {
     public:
+        CameraSystem();
+
         void Init(ContextPtr &ctx) override;
+        void Tick(ContextPtr &ctx) override;
+        void SceneView(ContextPtr &ctx) override;
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
+
+        /**
+         * @brief Copies the world space pose of every camera from its WorldTransform, or its Transform until it has one.
+         */
+        static void UpdatePose(Scene &scene);
     };
 }
\ No newline at end of file
@@ -31,52 +31,31 @@ aryanbaburajan2007@gmail.com
 
 namespace DT
 {
-    void DirectionalLightSystem::Init(ContextPtr &ctx)
+    DirectionalLightSystem::DirectionalLightSystem()
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<DirectionalLight>())
-        {
-            DirectionalLight *dl = ctx.sceneManager->GetActiveScene().Get<DirectionalLight>(entity);
-
-            dl->shader.Load(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Shaders" / "Default.glsl"), ctx);
-            dl->transform = &ctx.sceneManager->GetActiveScene().Assign<Transform>(entity);
-
-            if (ctx.renderer->GetFreeDirectionalLightSpot(&dl->lightSpot) == false)
-            {
-                std::cerr << "DirectionalLight: No free light spots.\n";
-                continue;
-            }
-
-            dl->propertyString = "directionalLights[" + std::to_string(dl->lightSpot) + "].";
-            dl->shader.data->Use();
-            dl->shader.data->SetBool(dl->propertyString + "enabled", true);
-        }
+        // Submits to the renderer
+        access.Read<DirectionalLight, Transform, WorldTransform>();
     }
 
-    void DirectionalLightSystem::Tick(ContextPtr &ctx)
+    void DirectionalLightSystem::Init(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<DirectionalLight>())
-        {
-            DirectionalLight *dl = ctx.sceneManager->GetActiveScene().Get<DirectionalLight>(entity);
-
-            if (dl->lightSpot == NAN)
-                continue;
-
-            dl->shader.data->Use();
-            dl->shader.data->SetVec3(dl->propertyString + "direction", dl->transform->Forward());
-            dl->shader.data->SetVec3(dl->propertyString + "ambient", dl->color * dl->intensity);
-            dl->shader.data->SetVec3(dl->propertyString + "diffuse", dl->color * dl->intensity);
-            dl->shader.data->SetVec3(dl->propertyString + "specular", dl->color * dl->intensity);
-        }
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        for (auto [entity, dl] : scene.View<DirectionalLight>().each())
+            dl.transform = &scene.Assign<Transform>(entity);
     }
 
-    void DirectionalLightSystem::Destroy(ContextPtr &ctx)
+    void DirectionalLightSystem::Tick(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<DirectionalLight>())
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        auto worlds = scene.View<WorldTransform>();
+        for (auto [entity, dl] : scene.View<DirectionalLight>().each())
         {
-            DirectionalLight *dl = ctx.sceneManager->GetActiveScene().Get<DirectionalLight>(entity);
-
-            ctx.renderer->UnoccupyDirectionalLightSpot(dl->lightSpot);
-            dl->shader.data->SetBool(dl->propertyString + "enabled", true);
+            DirectionalLightData data;
+            data.direction = worlds.contains(entity) ? worlds.get<WorldTransform>(entity).Forward() : dl.transform->Forward();
+            data.ambient = dl.color * dl.intensity;
+            data.diffuse = dl.color * dl.intensity;
+            data.specular = dl.color * dl.intensity;
+            ctx.renderer->SubmitDirectionalLight(entity, data);
         }
     }
 
@@ -92,18 +71,16 @@ namespace DT
 
     void DirectionalLightSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<DirectionalLight>())
-        {
-            if (selectedEntity != entity)
-                continue;
+        auto view = ctx.sceneManager->GetActiveScene().View<DirectionalLight>();
+        if (!view.contains(selectedEntity))
+            return;
 
-            DirectionalLight *dl = ctx.sceneManager->GetActiveScene().Get<DirectionalLight>(entity);
+        DirectionalLight &dl = view.get<DirectionalLight>(selectedEntity);
 
-            if (ImGui::CollapsingHeader("Directional Light"))
-            {
-                ImGui::DragFloat("intensity", &dl->intensity, 0.1f, 0.f, 5.f);
-                ImGui::ColorEdit3("color", &dl->color.x);
-            }
+        if (ImGui::CollapsingHeader("Directional Light"))
+        {
+            ImGui::DragFloat("intensity", &dl.intensity, 0.1f, 0.f, 5.f);
+            ImGui::ColorEdit3("color", &dl.color.x);
         }
     }
 }
\ No newline at end of file
@@ -34,14 +34,11 @@ namespace DT
      */
     struct DirectionalLight
     {
-        Resource<Shader> shader;          /// @brief Shader used by the directional light.
         float intensity = 1.f;            /// @brief Intensity of the directional light.
         glm::vec3 color = glm::vec3(1.f); /// @brief Color of the directional light.
 
     private:
         Transform *transform;
-        unsigned int lightSpot;     /// @brief Index of this Light in the Shader's light container.
-        std::string propertyString; /// @brief Shader property access code stored to avoid repetitive reconstruction.
 
         friend class DirectionalLightSystem;
     };
@@ -51,11 +48,12 @@ namespace DT
     class DirectionalLightSystem : public System
     {
     public:
+        DirectionalLightSystem();
+
         void Init(ContextPtr &ctx) override;
         void Tick(ContextPtr &ctx) override;
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
         void SceneView(ContextPtr &ctx) override;
-        void Destroy(ContextPtr &ctx) override;
     };
 }
\ No newline at end of file
@@ -27,44 +27,74 @@ aryanbaburajan2007@gmail.com
 #include <Components/Transform.h>
 #include <Core/Serialization.h>
 #include <Core/Resource.h>
+#include <Core/JobSystem.h>
 
 #include <Components/MeshRenderer.h>
 
 namespace DT
 {
+    MeshRendererSystem::MeshRendererSystem()
+    {
+        // Picks the LOD and submits to the renderer
+        access.Write<MeshRenderer, Transform>().Read<WorldTransform>();
+    }
+
     void MeshRendererSystem::Init(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<MeshRenderer>())
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        for (auto [entity, mr] : scene.View<MeshRenderer>().each())
         {
-            MeshRenderer *mr = ctx.sceneManager->GetActiveScene().Get<MeshRenderer>(entity);
+            mr.transform = &scene.Assign<Transform>(entity);
 
-            mr->transform = &ctx.sceneManager->GetActiveScene().Assign<Transform>(entity);
+            // Joins the group right away instead of whenever the TransformSystem inserts it from its job
+            TransformSystem::ConnectCleanup(scene.registry);
+            scene.Assign<WorldTransform>(entity);
 
-            mr->mesh.data->Setup();
+            // Read on the loader threads, set up on the main thread once decoded, drawn from then on
+            mr.mesh.LoadAsync(mr.mesh.rid, ctx);
         }
     }
 
     void MeshRendererSystem::Tick(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<MeshRenderer>())
-        {
-            MeshRenderer *mr = ctx.sceneManager->GetActiveScene().Get<MeshRenderer>(entity);
-
-            mr->mesh.data->Draw(mr->transform->GetModelMatrix(), *ctx.renderer);
+        SubmitInstances(ctx);
 
-            Transform *transform = ctx.sceneManager->GetActiveScene().Get<Transform>(entity);
-            transform->translation += glm::vec3(1.f);
-        }
+        for (Instance &instance : instances)
+            instance.meshRenderer->transform->translation += glm::vec3(1.f);
     }
 
     void MeshRendererSystem::SceneView(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<MeshRenderer>())
-        {
-            MeshRenderer *mr = ctx.sceneManager->GetActiveScene().Get<MeshRenderer>(entity);
+        SubmitInstances(ctx);
+    }
 
-            mr->mesh.data->Draw(mr->transform->GetModelMatrix(), *ctx.renderer);
-        }
+    void MeshRendererSystem::SubmitInstances(ContextPtr &ctx)
+    {
+        // Picking finished loads up touches the resource cache, which stays on this thread. The group packs the mesh
+        // renderers with a world transform at the front of their storage, Transform stays out of it since components
+        // keep pointers into its storage.
+        instances.clear();
+        auto group = ctx.sceneManager->GetActiveScene().registry.group<MeshRenderer>(entt::get<WorldTransform>);
+        for (auto [entity, mr, world] : group.each())
+            if (mr.mesh.IsReady())
+                instances.push_back({&mr, &world, glm::mat4(1.f), false});
+
+        // Every instance only touches its own mesh renderer
+        ctx.jobSystem->ParallelFor(instances.size(), [&](size_t begin, size_t end)
+                                   {
+                                       for (size_t i = begin; i < end; i++)
+                                       {
+                                           Instance &instance = instances[i];
+                                           MeshRenderer *mr = instance.meshRenderer;
+                                           instance.model = instance.world->world;
+                                           mr->lod = ctx.renderer->SelectLOD(*mr->mesh.data, instance.model, mr->lod);
+                                           instance.culled = ctx.renderer->IsCulled(*mr->mesh.data, instance.model);
+                                       } }, 256);
+
+        for (const Instance &instance : instances)
+            ctx.renderer->Submit(instance.meshRenderer->mesh.data, instance.model, instance.meshRenderer->lod, instance.culled);
+
+        ctx.renderer->FlushBatches();
     }
 
     void MeshRendererSystem::Serialize(ContextPtr &ctx, Entity entity)
@@ -74,18 +104,16 @@ namespace DT
 
     void MeshRendererSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<MeshRenderer>())
-        {
-            if (selectedEntity != entity)
-                continue;
+        auto view = ctx.sceneManager->GetActiveScene().View<MeshRenderer>();
+        if (!view.contains(selectedEntity))
+            return;
 
-            MeshRenderer *mr = ctx.sceneManager->GetActiveScene().Get<MeshRenderer>(entity);
+        MeshRenderer &mr = view.get<MeshRenderer>(selectedEntity);
 
-            if (ImGui::CollapsingHeader("Mesh Renderer"))
-            {
-                ImGui::Resource("mesh", &mr->mesh, ctx);
-                // ImGui::Resource("material", mr->material);
-            }
+        if (ImGui::CollapsingHeader("Mesh Renderer"))
+        {
+            ImGui::Resource("mesh", &mr.mesh, ctx);
+            // ImGui::Resource("material", mr.material);
         }
     }
 }
\ No newline at end of file
@@ -22,12 +22,15 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <vector>
+
 #include <Core/Resource.h>
 #include <Renderer/Mesh.h>
 
 namespace DT
 {
     class Transform;
+    struct WorldTransform;
 
     /**
      * @brief MeshRenderer component for rendering mesh.
@@ -38,6 +41,7 @@ namespace DT
 
     private:
         Transform *transform;
+        unsigned int lod = 0; /// @brief Level of detail drawn last frame.
 
         friend class MeshRendererSystem;
     };
@@ -47,10 +51,28 @@ namespace DT
     class MeshRendererSystem : public System
     {
     public:
+        MeshRendererSystem();
+
         void Init(ContextPtr &ctx) override;
         void Tick(ContextPtr &ctx) override;
         void SceneView(ContextPtr &ctx) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
+
+    private:
+        struct Instance
+        {
+            MeshRenderer *meshRenderer;
+            const WorldTransform *world;
+            glm::mat4 model;
+            bool culled;
+        };
+
+        std::vector<Instance> instances; /// @brief The loaded mesh renderers of the last submission, kept to reuse the storage.
+
+        /**
+         * @brief Selects LODs and culls the loaded mesh renderers on the JobSystem, then submits them in order and flushes the batches.
+         */
+        void SubmitInstances(ContextPtr &ctx);
     };
 }
\ No newline at end of file
@@ -31,62 +31,49 @@ aryanbaburajan2007@gmail.com
 
 namespace DT
 {
-    void PointLightSystem::Init(ContextPtr &ctx)
+    PointLightSystem::PointLightSystem()
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<PointLight>())
-        {
-            PointLight *pl = ctx.sceneManager->GetActiveScene().Get<PointLight>(entity);
-
-            pl->shader.Load(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Editor" / "Shaders" / "Default.glsl"), ctx);
-            pl->transform = &ctx.sceneManager->GetActiveScene().Assign<Transform>(entity);
-
-            if (ctx.renderer->GetFreePointLightSpot(&pl->lightSpot) == false)
-            {
-                std::cerr << "PointLight: No free light spots.\n";
-            }
-
-            pl->propertyString = "pointLights[" + std::to_string(pl->lightSpot) + "].";
+        // Submits to the renderer
+        access.Read<PointLight, Transform, WorldTransform>();
+    }
 
-            pl->shader.data->Use();
-            pl->shader.data->SetFloat(pl->propertyString + "constant", 1.0f);
-            pl->shader.data->SetFloat(pl->propertyString + "quadratic", 1.0f);
-            pl->shader.data->SetBool(pl->propertyString + "enabled", true);
-        }
+    void PointLightSystem::Init(ContextPtr &ctx)
+    {
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        for (auto [entity, pl] : scene.View<PointLight>().each())
+            pl.transform = &scene.Assign<Transform>(entity);
     }
 
     void PointLightSystem::Tick(ContextPtr &ctx)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<PointLight>())
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        auto worlds = scene.View<WorldTransform>();
+        for (auto [entity, pl] : scene.View<PointLight>().each())
         {
-            PointLight *pl = ctx.sceneManager->GetActiveScene().Get<PointLight>(entity);
-
-            if (pl->lightSpot == NAN)
-                return;
-
-            pl->shader.data->Use();
-            pl->shader.data->SetVec3(pl->propertyString + "position", pl->transform->translation);
-
-            pl->shader.data->SetFloat(pl->propertyString + "linear", pl->intensity);
-            pl->shader.data->SetVec3(pl->propertyString + "ambient", pl->color * pl->intensity);
-            pl->shader.data->SetVec3(pl->propertyString + "diffuse", pl->color * pl->intensity);
-            pl->shader.data->SetVec3(pl->propertyString + "specular", pl->color * pl->intensity);
+            PointLightData data;
+            data.position = worlds.contains(entity) ? worlds.get<WorldTransform>(entity).GetPosition() : pl.transform->translation;
+            data.constant = 1.0f;
+            data.linear = pl.intensity;
+            data.quadratic = 1.0f;
+            data.ambient = pl.color * pl.intensity;
+            data.diffuse = pl.color * pl.intensity;
+            data.specular = pl.color * pl.intensity;
+            ctx.renderer->SubmitPointLight(entity, data);
         }
     }
 
     void PointLightSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
     {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<PointLight>())
-        {
-            if (selectedEntity != entity)
-                continue;
+        auto view = ctx.sceneManager->GetActiveScene().View<PointLight>();
+        if (!view.contains(selectedEntity))
+            return;
 
-            PointLight *pl = ctx.sceneManager->GetActiveScene().Get<PointLight>(entity);
+        PointLight &pl = view.get<PointLight>(selectedEntity);
 
-            if (ImGui::CollapsingHeader("Point Light"))
-            {
-                ImGui::DragFloat("intensity", &pl->intensity);
-                ImGui::ColorEdit3("color", &pl->color.x);
-            }
+        if (ImGui::CollapsingHeader("Point Light"))
+        {
+            ImGui::DragFloat("intensity", &pl.intensity);
+            ImGui::ColorEdit3("color", &pl.color.x);
         }
     }
 
@@ -99,15 +86,4 @@ namespace DT
     {
         ctx.sceneManager->GetActiveScene().SerializeComponent<PointLight>("PointLight", entity, ctx.sceneManager->GetActiveScene());
     }
-
-    void PointLightSystem::Destroy(ContextPtr &ctx)
-    {
-        for (Entity entity : ctx.sceneManager->GetActiveScene().View<PointLight>())
-        {
-            PointLight *pl = ctx.sceneManager->GetActiveScene().Get<PointLight>(entity);
-
-            ctx.renderer->UnoccupyPointLightSpot(pl->lightSpot);
-            pl->shader.data->SetBool(pl->propertyString + "enabled", false); // TOFIX: Move this to Renderer class
-        }
-    }
 }
\ No newline at end of file
@@ -31,14 +31,11 @@ namespace DT
      */
     struct PointLight
     {
-        Resource<Shader> shader;          /// @brief Shader used by the point light.
         float intensity = 1.f;            /// @brief Intensity of the point light.
         glm::vec3 color = glm::vec3(1.f); /// @brief Color of the point light.
 
     private:
         Transform *transform;
-        unsigned int lightSpot;     /// @brief Index of this Light in the Shader's light container.
-        std::string propertyString; /// @brief Shader property access code stored to avoid repetitive reconstruction.
 
         friend class PointLightSystem;
     };
@@ -48,13 +45,15 @@ namespace DT
     class PointLightSystem : public System
     {
     public:
+        PointLightSystem();
+
         /**
-         * @brief Registers Point Light to rendering engine and shader on Initiation.
+         * @brief Attaches the Point Light to its Transform on Initiation.
          */
         void Init(ContextPtr &ctx) override;
 
         /**
-         * @brief Updates corresponding Point Light properties in shader every frame.
+         * @brief Submits the Point Light to the renderer's light list every frame.
          */
         void Tick(ContextPtr &ctx) override;
 
@@ -72,10 +71,5 @@ namespace DT
          * @brief Handles Scene View lighting.
          */
         void SceneView(ContextPtr &ctx) override;
-
-        /**
-         * @brief Unregisters Point Light from rendering engine and shader on destruction.
-         */
-        void Destroy(ContextPtr &ctx) override;
     };
 }
\ No newline at end of file
@@ -36,12 +36,13 @@ namespace DT
 {
     void RegisterComponentSystems(Scene &scene)
     {
+        // World matrices are updated before anything reads them
+        scene.Register<TransformSystem>();
         scene.Register<CameraSystem>();
         scene.Register<DirectionalLightSystem>();
         scene.Register<MeshRendererSystem>();
         scene.Register<PointLightSystem>();
         scene.Register<TagSystem>();
-        scene.Register<TransformSystem>();
         scene.Register<RelationSystem>();
     }
 }
\ No newline at end of file
@@ -27,59 +27,182 @@ aryanbaburajan2007@gmail.com
 #include <Scene/Scene.h>
 #include <Core/ImGui.h>
 #include <Scene/SceneManager.h>
+#include <Components/Transform.h>
 #include <Components/Relation.h>
 
 namespace DT
 {
-    void Relation::SetParent(Entity parentEntity, Scene &scene)
+    namespace
     {
-        Entity entity = Scene::From(*this, scene);
-
-        Relation &parentRelation = scene.Assign<Relation>(parentEntity);
-        Relation &childRelation = scene.Assign<Relation>(entity);
+        // Reparenting changes the world matrix without touching the Transform
+        void MarkWorldDirty(Entity entity, entt::registry &registry)
+        {
+            if (WorldTransform *world = registry.try_get<WorldTransform>(entity))
+                world->dirty = true;
+        }
 
-        parentRelation.children.insert(entity);
-        parent = parentEntity;
-        hasParent = true;
+        bool HasRelation(Entity entity, const entt::registry &registry)
+        {
+            return entity != entt::null && registry.valid(entity) && registry.all_of<Relation>(entity);
+        }
     }
 
-    void Relation::RemoveParent(Scene &scene)
+    void Relation::Unlink(Entity child, entt::registry &registry)
     {
-        if (parent == entt::null)
+        Relation &relation = registry.get<Relation>(child);
+        if (!relation.hasParent)
             return;
 
+        if (relation.previousSibling != entt::null)
+            registry.get<Relation>(relation.previousSibling).nextSibling = relation.nextSibling;
+        else if (HasRelation(relation.parent, registry))
+            registry.get<Relation>(relation.parent).firstChild = relation.nextSibling;
+        if (relation.nextSibling != entt::null)
+            registry.get<Relation>(relation.nextSibling).previousSibling = relation.previousSibling;
+        if (HasRelation(relation.parent, registry))
+            registry.get<Relation>(relation.parent).childCount--;
+
+        relation.hasParent = false;
+        relation.parent = relation.previousSibling = relation.nextSibling = entt::null;
+
+        MarkWorldDirty(child, registry);
+        HierarchyOrder::Invalidate(registry);
+    }
+
+    void Relation::Link(Entity parent, Entity child, entt::registry &registry)
+    {
+        for (Entity ancestor = parent; HasRelation(ancestor, registry); ancestor = registry.get<Relation>(ancestor).parent)
+        {
+            if (ancestor == child)
+            {
+                std::cout << "[ERR] [RELATION] Entity " << entt::to_integral(child) << " can't become a child of its own descendant " << entt::to_integral(parent) << ".\n";
+                return;
+            }
+        }
+
+        Unlink(child, registry);
+
+        Relation &parentRelation = registry.get<Relation>(parent);
+        Relation &childRelation = registry.get<Relation>(child);
+
+        childRelation.nextSibling = parentRelation.firstChild;
+        if (parentRelation.firstChild != entt::null)
+            registry.get<Relation>(parentRelation.firstChild).previousSibling = child;
+        parentRelation.firstChild = child;
+        parentRelation.childCount++;
+
+        childRelation.parent = parent;
+        childRelation.hasParent = true;
+
+        MarkWorldDirty(child, registry);
+        HierarchyOrder::Invalidate(registry);
+    }
+
+    void Relation::SetParent(Entity parentEntity, Scene &scene)
+    {
         Entity entity = Scene::From(*this, scene);
 
-        Relation &parentRelation = scene.Assign<Relation>(parent);
-        Relation &childRelation = scene.Assign<Relation>(entity);
+        // Adding the parent's Relation may move this one
+        scene.Assign<Relation>(parentEntity);
+        Link(parentEntity, entity, scene.registry);
+    }
 
-        parentRelation.children.erase(entity);
-        parent = entt::null;
-        hasParent = false;
+    void Relation::RemoveParent(Scene &scene)
+    {
+        Unlink(Scene::From(*this, scene), scene.registry);
     }
 
     void Relation::AddChild(Entity child, Scene &scene)
     {
         Entity entity = Scene::From(*this, scene);
 
-        Relation &parentRelation = scene.Assign<Relation>(entity);
-        Relation &childRelation = scene.Assign<Relation>(child);
-
-        children.insert(child);
-        childRelation.parent = entity;
-        childRelation.hasParent = true;
+        scene.Assign<Relation>(child);
+        Link(entity, child, scene.registry);
     }
 
     void Relation::RemoveChild(Entity child, Scene &scene)
     {
         Entity entity = Scene::From(*this, scene);
 
-        Relation &parentRelation = scene.Assign<Relation>(entity);
-        Relation &childRelation = scene.Assign<Relation>(child);
+        if (HasRelation(child, scene.registry) && scene.registry.get<Relation>(child).parent == entity)
+            Unlink(child, scene.registry);
+    }
+
+    const HierarchyOrder &HierarchyOrder::Get(entt::registry &registry)
+    {
+        HierarchyOrder *order = registry.ctx().find<HierarchyOrder>();
+        if (order == nullptr)
+        {
+            order = &registry.ctx().emplace<HierarchyOrder>();
+            registry.on_construct<Relation>().connect<&HierarchyOrder::Invalidate>();
+            registry.on_destroy<Relation>().connect<&HierarchyOrder::Invalidate>();
+        }
+
+        if (order->sorted)
+            return *order;
+
+        order->entities.clear();
+        order->subtrees.clear();
+
+        auto relations = registry.view<Relation>();
+        for (Entity root : relations)
+        {
+            if (relations.get<Relation>(root).hasParent && HasRelation(relations.get<Relation>(root).parent, registry))
+                continue;
+
+            // Preorder walk following the links, no stack needed
+            order->subtrees.push_back(order->entities.size());
+            for (Entity entity = root; entity != entt::null && order->entities.size() < relations.size();)
+            {
+                order->entities.push_back(entity);
+
+                const Relation *relation = &relations.get<Relation>(entity);
+                if (relation->firstChild != entt::null)
+                {
+                    entity = relation->firstChild;
+                    continue;
+                }
 
-        children.erase(child);
-        childRelation.parent = entt::null;
-        childRelation.hasParent = false;
+                while (entity != root && relation->nextSibling == entt::null)
+                {
+                    entity = relation->parent;
+                    relation = &relations.get<Relation>(entity);
+                }
+                entity = entity == root ? Entity(entt::null) : relation->nextSibling;
+            }
+        }
+        order->subtrees.push_back(order->entities.size());
+
+        if (order->entities.size() != relations.size())
+            std::cout << "[ERR] [RELATION] " << relations.size() - order->entities.size() << " entities are part of a parent cycle and left out of the hierarchy.\n";
+
+        // Lay the Relation storage out in the same order, entities left out go last
+        std::vector<size_t> positions;
+        for (size_t i = 0; i < order->entities.size(); i++)
+        {
+            size_t index = entt::to_entity(order->entities[i]);
+            if (index >= positions.size())
+                positions.resize(index + 1, order->entities.size());
+            positions[index] = i;
+        }
+        registry.sort<Relation>([&positions](const Entity lhs, const Entity rhs)
+                                {
+                                    auto position = [&positions](Entity entity)
+                                    {
+                                        size_t index = entt::to_entity(entity);
+                                        return index < positions.size() ? positions[index] : positions.size();
+                                    };
+                                    return position(lhs) < position(rhs); });
+
+        order->version++;
+        order->sorted = true;
+        return *order;
+    }
+
+    void HierarchyOrder::Invalidate(entt::registry &registry, Entity entity)
+    {
+        if (HierarchyOrder *order = registry.ctx().find<HierarchyOrder>())
+            order->sorted = false;
     }
 
     template <typename T>
@@ -87,6 +210,12 @@ namespace DT
     {
     }
 
+    RelationSystem::RelationSystem()
+    {
+        // Nothing to tick
+        access.Read<Relation>().AnyThread();
+    }
+
     void RelationSystem::Init(ContextPtr &ctx)
     {
         for (Entity entity : ctx.sceneManager->GetActiveScene().View<Relation>())
@@ -107,22 +236,37 @@ namespace DT
 
             if (ImGui::CollapsingHeader("Relation"))
             {
-                ImGui::Entity("parent", &relation->parent);
+                // Edited on a copy, the sibling links and the hierarchy order only change through Link and Unlink
+                Scene &scene = ctx.sceneManager->GetActiveScene();
+                Entity parent = relation->hasParent ? relation->parent : entt::null;
+                ImGui::Entity("parent", &parent);
+
+                if (parent != (relation->hasParent ? relation->parent : entt::null))
+                {
+                    if (parent == entt::null)
+                        relation->RemoveParent(scene);
+                    else if (scene.registry.valid(parent) && parent != entity)
+                        relation->SetParent(parent, scene);
+                }
             }
         }
     }
 
     void RelationSystem::Serialize(ContextPtr &ctx, Entity entity)
     {
-        ctx.sceneManager->GetActiveScene().SerializeComponent<Relation>("Relation", entity, ctx.sceneManager->GetActiveScene());
+        Scene &scene = ctx.sceneManager->GetActiveScene();
+        scene.SerializeComponent<Relation>("Relation", entity, scene);
+
+        // Loading assigns the links directly instead of going through Link
+        if (!scene.isSerializing)
+            HierarchyOrder::Invalidate(scene.registry);
     }
 
     void RelationSystem::OnDestroy(entt::registry &registry, Entity entity)
     {
-        Scene *scene = Scene::GetSceneFromRegistry(registry);
-        Relation *relation = scene->Get<Relation>(entity);
-        relation->RemoveParent(*scene);
-        for (const Entity &child : relation->children)
-            relation->RemoveChild(child, *scene);
+        // The children become roots
+        Relation::Unlink(entity, registry);
+        registry.get<Relation>(entity).ForEachChild(registry, [&registry](Entity child)
+                                                    { Relation::Unlink(child, registry); });
     }
 }
\ No newline at end of file
@@ -22,16 +22,24 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <vector>
+
 namespace DT
 {
     /**
      * @brief Relation component for Parent-Child relationships.
+     *
+     * Children are linked through their own Relation as a doubly linked list of siblings starting at firstChild, so
+     * the hierarchy is walked without any allocation per child.
      */
     struct Relation
     {
         bool hasParent = false;              /// @brief Flag indicating whether the current Entity has a parent.
         Entity parent = entt::null;          /// @brief Parent of the current Entity. Equals to `entt::null` when `hasParent` is `false`.
-        std::unordered_set<Entity> children; /// @brief List of children owned by current Entity.
+        unsigned int childCount = 0;         /// @brief Number of children owned by current Entity.
+        Entity firstChild = entt::null;      /// @brief First child of the current Entity, the others follow through nextSibling.
+        Entity previousSibling = entt::null; /// @brief Previous child of the parent, `entt::null` for the first one.
+        Entity nextSibling = entt::null;     /// @brief Next child of the parent, `entt::null` for the last one.
 
         /**
          * @brief Sets the parent of the current Entity.
@@ -63,16 +71,73 @@ namespace DT
          * @param scene Reference to the Scene object.
          */
         void RemoveChild(Entity child, Scene &scene);
+
+        /**
+         * @brief Makes child the first child of parent, taking it from its previous parent. Refuses to create a cycle.
+         *
+         * @param registry The registry holding both entities, which need a Relation.
+         */
+        static void Link(Entity parent, Entity child, entt::registry &registry);
+
+        /**
+         * @brief Takes an entity out of its parent's children, making it a root.
+         *
+         * @param registry The registry holding the entity, which needs a Relation.
+         */
+        static void Unlink(Entity child, entt::registry &registry);
+
+        /**
+         * @brief Calls function(child) for every child of the current Entity. The function may unparent the child it is given.
+         *
+         * @param registry The registry holding the children.
+         */
+        template <typename F>
+        void ForEachChild(const entt::registry &registry, F function) const
+        {
+            for (Entity child = firstChild; child != entt::null;)
+            {
+                Entity next = registry.get<Relation>(child).nextSibling;
+                function(child);
+                child = next;
+            }
+        }
     };
 
-    SERIALIZE(Relation, hasParent, parent, children);
+    SERIALIZE(Relation, hasParent, parent, childCount, firstChild, previousSibling, nextSibling);
+
+    /**
+     * @brief Depth first order of the entities with a Relation, kept in the context of their registry.
+     *
+     * Parents come before their children and every subtree is contiguous, so the hierarchy can be updated in one
+     * linear pass and independent subtrees in parallel. The order is rebuilt, and the Relation storage sorted the
+     * same way, the first time it is asked for after the hierarchy changed.
+     */
+    struct HierarchyOrder
+    {
+        std::vector<Entity> entities; /// @brief Every entity of the hierarchy, parents first.
+        std::vector<size_t> subtrees; /// @brief Where the subtree of each root starts in entities, then entities.size().
+        unsigned int version = 0;     /// @brief Incremented on every rebuild, for storages that follow the Relation order.
+        bool sorted = false;          /// @brief Whether the order still matches the hierarchy.
+
+        /**
+         * @brief Returns the order of the hierarchy of a registry, rebuilding it first if it changed since.
+         */
+        static const HierarchyOrder &Get(entt::registry &registry);
+
+        /**
+         * @brief Marks the order of a registry as outdated. Called whenever a Relation is linked, unlinked, added or removed.
+         */
+        static void Invalidate(entt::registry &registry, Entity entity = entt::null);
+    };
 
     class RelationSystem : public System
     {
     public:
+        RelationSystem();
+
         void Init(ContextPtr &ctx) override;
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
         void OnDestroy(entt::registry &registry, entt::entity entity) override;
     };
-}
\ No newline at end of file
+}
@@ -32,6 +32,12 @@ aryanbaburajan2007@gmail.com
 
 namespace DT
 {
+    TagSystem::TagSystem()
+    {
+        // Nothing to tick
+        access.Read<Tag>().AnyThread();
+    }
+
     void TagSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
     {
         for (Entity entity : ctx.sceneManager->GetActiveScene().View<Tag>())
@@ -37,6 +37,8 @@ namespace DT
     class TagSystem : public System
     {
     public:
+        TagSystem();
+
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
     };
@@ -25,6 +25,8 @@ aryanbaburajan2007@gmail.com
 #include <Scene/Scene.h>
 #include <Core/ImGui.h>
 #include <Core/Serialization.h>
+#include <Core/JobSystem.h>
+#include <Components/Relation.h>
 
 #include <Components/Transform.h>
 
@@ -71,6 +73,106 @@ namespace DT
         rotation = glm::radians(eulerRotation);
     }
 
+    TransformSystem::TransformSystem()
+    {
+        // Sorting the hierarchy rearranges the Relation storage
+        access.Read<Transform>().Write<Relation, WorldTransform>().AnyThread();
+    }
+
+    void TransformSystem::Tick(ContextPtr &ctx)
+    {
+        Propagate(ctx.sceneManager->GetActiveScene().registry, *ctx.jobSystem);
+    }
+
+    void TransformSystem::SceneView(ContextPtr &ctx)
+    {
+        Propagate(ctx.sceneManager->GetActiveScene().registry, *ctx.jobSystem);
+    }
+
+    namespace
+    {
+        /**
+         * @brief Kept in the context of the registries whose Transform removals also remove the WorldTransform.
+         */
+        struct WorldTransformCleanup
+        {
+        };
+    }
+
+    void TransformSystem::ConnectCleanup(entt::registry &registry)
+    {
+        if (registry.ctx().contains<WorldTransformCleanup>())
+            return;
+        registry.ctx().emplace<WorldTransformCleanup>();
+        registry.on_destroy<Transform>().connect<&entt::registry::remove<WorldTransform>>();
+    }
+
+    void TransformSystem::Propagate(entt::registry &registry, JobSystem &jobSystem)
+    {
+        ConnectCleanup(registry);
+
+        auto added = registry.view<Transform>(entt::exclude<WorldTransform>);
+        std::vector<Entity> addedEntities(added.begin(), added.end());
+        registry.insert<WorldTransform>(addedEntities.begin(), addedEntities.end());
+
+        // Entities outside of the hierarchy only depend on themselves
+        auto unrelated = registry.view<const Transform, WorldTransform>(entt::exclude<Relation>);
+        jobSystem.ParallelForEach(unrelated, [&unrelated](Entity entity)
+                                  { Update(unrelated.get<const Transform>(entity), unrelated.get<WorldTransform>(entity), nullptr); });
+
+        // Keep the matrices next to each other in the order the hierarchy is walked in
+        const HierarchyOrder &order = HierarchyOrder::Get(registry);
+        if (order.version != sortedVersion)
+        {
+            registry.sort<WorldTransform, Relation>();
+            sortedVersion = order.version;
+        }
+
+        // Going through the storages skips looking them up in the registry for every component
+        const auto &transforms = registry.storage<Transform>();
+        auto &worlds = registry.storage<WorldTransform>();
+        const auto &relations = registry.storage<Relation>();
+
+        // Parents come before their children, the subtrees don't share anything
+        jobSystem.ParallelFor(order.subtrees.size() - 1, [&](size_t begin, size_t end)
+                              {
+                                  for (size_t i = order.subtrees[begin]; i < order.subtrees[end]; i++)
+                                  {
+                                      Entity entity = order.entities[i];
+                                      if (!worlds.contains(entity) || !transforms.contains(entity))
+                                          continue;
+
+                                      // The hierarchy only passes through entities with a Transform, others can
+                                      // still be given a WorldTransform directly
+                                      const Relation &relation = relations.get(entity);
+                                      const WorldTransform *parent = relation.hasParent && worlds.contains(relation.parent) ? &worlds.get(relation.parent) : nullptr;
+                                      Update(transforms.get(entity), worlds.get(entity), parent);
+                                  } });
+    }
+
+    void TransformSystem::Update(const Transform &transform, WorldTransform &world, const WorldTransform *parent)
+    {
+        bool changed = world.dirty || transform.translation != world.translation || transform.rotation != world.rotation || transform.scale != world.scale;
+        if (changed)
+        {
+            world.translation = transform.translation;
+            world.rotation = transform.rotation;
+            world.scale = transform.scale;
+            world.local = glm::translate(glm::mat4(1.f), world.translation) * glm::toMat4(world.rotation) * glm::scale(glm::mat4(1.f), world.scale);
+        }
+
+        changed |= parent != nullptr && parent->changed;
+        if (changed)
+        {
+            world.world = parent == nullptr ? world.local : parent->world * world.local;
+            world.dirty = false;
+        }
+
+        // Static entities are only read, their memory stays clean
+        if (world.changed != changed)
+            world.changed = changed;
+    }
+
     void TransformSystem::Inspector(ContextPtr &ctx, Entity selectedEntity)
     {
         for (Entity entity : ctx.sceneManager->GetActiveScene().View<Transform>())
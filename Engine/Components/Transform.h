@@ -23,6 +23,7 @@ aryanbaburajan2007@gmail.com
 #pragma once
 
 #include <functional>
+#include <vector>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
@@ -90,13 +91,72 @@ namespace DT
 
     SERIALIZE(Transform, translation, rotation, scale);
 
+    /**
+     * @brief Cached model matrices of a Transform, kept up to date by the TransformSystem for every entity with a Transform.
+     *
+     * A Transform counts as changed when its members differ from the ones local was built from, so writing to them
+     * directly is picked up without a setter. Entities whose Transform and parents didn't change keep their matrices.
+     */
+    struct WorldTransform
+    {
+        glm::mat4 local = glm::mat4(1.f); /// @brief Model matrix of the Transform alone.
+        glm::mat4 world = glm::mat4(1.f); /// @brief Model matrix including the ones of the parents, what the entity is rendered with.
+        bool dirty = true;                /// @brief Rebuilds both matrices on the next propagation even if the Transform didn't change.
+
+        /**
+         * @brief Returns the world space position of the entity.
+         */
+        glm::vec3 GetPosition() const { return glm::vec3(world[3]); }
+
+        /**
+         * @brief Returns the world space forward vector of the entity.
+         */
+        glm::vec3 Forward() const { return glm::normalize(glm::vec3(world * glm::vec4(0.f, 0.f, 1.f, 0.f))); }
+
+    private:
+        // The Transform members local was built from
+        glm::vec3 translation = glm::vec3(0.f);
+        glm::quat rotation = glm::quat(0.f, 0.f, 0.f, 0.f);
+        glm::vec3 scale = glm::vec3(1.f);
+        bool changed = false; // Whether world changed in the last propagation, tells the children to follow
+
+        friend class TransformSystem;
+    };
+
     class Scene;
+    class JobSystem;
 
     class TransformSystem : public System
     {
     public:
+        TransformSystem();
+
+        void Tick(ContextPtr &ctx) override;
+        void SceneView(ContextPtr &ctx) override;
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override;
         void Serialize(ContextPtr &ctx, Entity entity) override;
         void PopupContext(const char *label, std::function<void()> func);
+
+        /**
+         * @brief Gives every Transform a WorldTransform and updates the ones whose Transform or parents changed.
+         *
+         * Entities outside of the hierarchy are updated in parallel, the hierarchy in one pass over its HierarchyOrder
+         * with independent subtrees on the JobSystem.
+         */
+        void Propagate(entt::registry &registry, JobSystem &jobSystem);
+
+        /**
+         * @brief Makes removing a Transform remove the WorldTransform of the entity as well, once per registry. Called
+         * by Propagate and by anything that assigns a WorldTransform before the first propagation.
+         */
+        static void ConnectCleanup(entt::registry &registry);
+
+    private:
+        unsigned int sortedVersion = 0; /// @brief HierarchyOrder version the WorldTransform storage was last sorted for.
+
+        /**
+         * @brief Rebuilds the matrices of an entity if its Transform or its parent's world matrix changed.
+         */
+        static void Update(const Transform &transform, WorldTransform &world, const WorldTransform *parent);
     };
 }
\ No newline at end of file
@@ -38,6 +38,9 @@ namespace DT
         pointer.sceneManager = &sceneManager;
         pointer.game = &game;
         pointer.resourceManager = &resourceManager;
+        pointer.resourceLoader = &resourceLoader;
+        pointer.hotReloader = &hotReloader;
+        pointer.jobSystem = &jobSystem;
         assert(pointer.resourceManager != nullptr);
         std::cout << __LINE__ << std::endl;
         pointer.ctx = this;
@@ -31,6 +31,10 @@ aryanbaburajan2007@gmail.com
 #include <Core/Debug.h>
 #include <Core/Project.h>
 #include <Core/ResourceManager.h>
+#include <Core/PackFile.h>
+#include <Core/ResourceLoader.h>
+#include <Core/HotReloader.h>
+#include <Core/JobSystem.h>
 #include <Core/Context.h>
 #include <Core/ContextPtr.h>
 #include <Scene/SceneManager.h>
@@ -51,6 +55,9 @@ namespace DT
 
         ContextPtr pointer;              /// @brief Pointer to the current context.
         ResourceManager resourceManager; /// @brief The resource manager instance.
+        ResourceLoader resourceLoader;   /// @brief The background resource loader instance.
+        HotReloader hotReloader;         /// @brief The resource hot reloader instance.
+        JobSystem jobSystem;             /// @brief The job system instance.
         Engine engine;                   /// @brief The engine instance.
         Window window;                   /// @brief The window instance.
         Renderer renderer;               /// @brief The renderer instance.
@@ -68,6 +75,11 @@ namespace DT
          */
         Context(const std::filesystem::path &projectPath) : resourceManager(), ctxPath(projectPath), window((InitializeContextPtr(), pointer)), renderer(pointer), input(pointer), game(pointer), sceneManager(pointer)
         {
+            // A pack shipped next to the project file replaces the loose files it holds
+            std::filesystem::path packPath = ctxPath.parent_path() / PackFile::fileName;
+            if (std::filesystem::exists(packPath))
+                resourceManager.Mount(packPath, ctxPath.parent_path());
+
             // Load context data from a JSON file
             from_json(json::parse(std::ifstream(ctxPath)), *this);
             std::cout << "[LOG] Context loaded from " << ctxPath.string() << "\n";
@@ -82,6 +94,7 @@ namespace DT
             nlohmann_json_j["renderer"] = nlohmann_json_t.renderer;
             nlohmann_json_j["sceneManager"] = nlohmann_json_t.sceneManager;
             nlohmann_json_j["resourceManager"] = nlohmann_json_t.resourceManager;
+            nlohmann_json_j["dependencyManifest"] = nlohmann_json_t.resourceManager.SaveManifest();
         }
         friend void from_json(const nlohmann::json &nlohmann_json_j, Context &nlohmann_json_t)
         {
@@ -89,6 +102,8 @@ namespace DT
             nlohmann_json_j.at("renderer").get_to(nlohmann_json_t.renderer);
             nlohmann_json_j.at("sceneManager").get_to(nlohmann_json_t.sceneManager);
             // nlohmann_json_j.at("resourceManager").get_to(nlohmann_json_t.resourceManager);
+            if (nlohmann_json_j.contains("dependencyManifest"))
+                nlohmann_json_t.resourceManager.LoadManifest(nlohmann_json_j.at("dependencyManifest"));
         }
 
     private:
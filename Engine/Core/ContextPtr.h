@@ -26,6 +26,9 @@ namespace DT
 {
     class Engine;
     class ResourceManager;
+    class ResourceLoader;
+    class HotReloader;
+    class JobSystem;
     class Window;
     class Renderer;
     class Input;
@@ -54,6 +57,9 @@ namespace DT
         SceneManager *sceneManager{NULL};
         Game *game{NULL};
         ResourceManager *resourceManager{NULL};
+        ResourceLoader *resourceLoader{NULL};
+        HotReloader *hotReloader{NULL};
+        JobSystem *jobSystem{NULL};
 
         friend class Context;
     };
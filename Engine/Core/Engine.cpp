@@ -24,6 +24,7 @@ aryanbaburajan2007@gmail.com
 #include <iostream>
 
 #include <Core/Engine.h>
+#include <Core/HotReloader.h>
 
 namespace DT
 {
@@ -59,11 +60,19 @@ namespace DT
 
         ctx.window->Clear({0.2f, 0.3f, 0.3f, 1.0f});
 
+        // Start reloading the resources whose files changed on disk
+        ctx.hotReloader->Update(ctx);
+
+        // Finish the resources the loader threads decoded since the last frame, within the upload budget
+        ctx.resourceLoader->ProcessUploads(ctx);
+
+        // Unload what nobody references anymore if that is needed to fit the memory budgets
+        ResourceCache::Trim();
+
         ctx.renderer->Render(ctx);
 
         if (ctx.loopManager->gameTick)
-            for (System *system : ctx.sceneManager->GetActiveScene().systems)
-                system->Tick(ctx);
+            scheduler.Tick(ctx.sceneManager->GetActiveScene(), ctx);
     }
 
     void Engine::EndFrame(Window &window)
@@ -31,6 +31,7 @@ aryanbaburajan2007@gmail.com
 #include <Core/Resource.h>
 #include <Core/ContextPtr.h>
 #include <Scene/SceneManager.h>
+#include <Scene/SystemScheduler.h>
 
 namespace DT
 {
@@ -40,6 +41,8 @@ namespace DT
     class Engine
     {
     public:
+        SystemScheduler scheduler; /// @brief Ticks the systems of the active scene.
+
         /**
          * @brief Destructor for the Engine class.
          */
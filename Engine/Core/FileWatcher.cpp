@@ -0,0 +1,215 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <Core/FileWatcher.h>
+
+namespace DT
+{
+    namespace
+    {
+        std::string Key(const std::filesystem::path &path)
+        {
+            return path.lexically_normal().generic_string();
+        }
+
+        /**
+         * @brief Compares modification times, used where no change notification API is available.
+         */
+        class PollingFileWatcher : public FileWatcher
+        {
+        public:
+            void Watch(const std::filesystem::path &path) override
+            {
+                std::error_code error;
+                files[Key(path)] = {path, std::filesystem::last_write_time(path, error)};
+            }
+
+            void Unwatch(const std::filesystem::path &path) override
+            {
+                files.erase(Key(path));
+            }
+
+            void Poll(std::vector<std::filesystem::path> &changed) override
+            {
+                // Stat'ing every file is expensive, don't do it on every call
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (now - lastPoll < std::chrono::milliseconds(500))
+                    return;
+                lastPoll = now;
+
+                for (auto &[key, file] : files)
+                {
+                    std::error_code error;
+                    std::filesystem::file_time_type time = std::filesystem::last_write_time(file.path, error);
+                    if (!error && time != file.time)
+                    {
+                        file.time = time;
+                        changed.push_back(file.path);
+                    }
+                }
+            }
+
+        private:
+            struct File
+            {
+                std::filesystem::path path;
+                std::filesystem::file_time_type time;
+            };
+
+            std::unordered_map<std::string, File> files;
+            std::chrono::steady_clock::time_point lastPoll;
+        };
+
+#ifdef __linux__
+        /**
+         * @brief Watches the directories of the files with inotify, so files saved by writing a temporary and renaming
+         * it over the original are still seen.
+         */
+        class InotifyFileWatcher : public FileWatcher
+        {
+        public:
+            int fd;
+
+            InotifyFileWatcher()
+            {
+                fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            }
+
+            ~InotifyFileWatcher() override
+            {
+                if (fd != -1)
+                    close(fd);
+            }
+
+            void Watch(const std::filesystem::path &path) override
+            {
+                std::string key = Key(path);
+                if (files.count(key))
+                    return;
+
+                std::filesystem::path directory = path.parent_path().empty() ? std::filesystem::path(".") : path.parent_path();
+                std::string directoryKey = Key(directory);
+                auto it = directories.find(directoryKey);
+                if (it == directories.end())
+                {
+                    int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                    if (wd == -1)
+                    {
+                        std::cout << "[ERR] [WATCH_FAIL] [" << directory.string() << "] errno " << errno << "\n";
+                        return;
+                    }
+                    it = directories.emplace(directoryKey, Directory{wd, directory, 0}).first;
+                    watches[wd] = directoryKey;
+                }
+
+                it->second.files++;
+                files.emplace(std::move(key), path);
+            }
+
+            void Unwatch(const std::filesystem::path &path) override
+            {
+                auto file = files.find(Key(path));
+                if (file == files.end())
+                    return;
+
+                std::filesystem::path directory = file->second.parent_path().empty() ? std::filesystem::path(".") : file->second.parent_path();
+                files.erase(file);
+
+                auto it = directories.find(Key(directory));
+                if (it != directories.end() && --it->second.files == 0)
+                {
+                    inotify_rm_watch(fd, it->second.wd);
+                    watches.erase(it->second.wd);
+                    directories.erase(it);
+                }
+            }
+
+            void Poll(std::vector<std::filesystem::path> &changed) override
+            {
+                alignas(inotify_event) char buffer[4096];
+                while (true)
+                {
+                    ssize_t length = read(fd, buffer, sizeof(buffer));
+                    if (length <= 0)
+                        return;
+
+                    for (ssize_t offset = 0; offset < length;)
+                    {
+                        const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                        offset += sizeof(inotify_event) + event->len;
+
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            // Events were lost, report everything rather than miss a change
+                            for (auto &[key, path] : files)
+                                changed.push_back(path);
+                            continue;
+                        }
+
+                        auto watch = watches.find(event->wd);
+                        if (watch == watches.end() || event->len == 0)
+                            continue;
+
+                        auto file = files.find(Key(directories.at(watch->second).path / event->name));
+                        if (file != files.end())
+                            changed.push_back(file->second);
+                    }
+                }
+            }
+
+        private:
+            struct Directory
+            {
+                int wd;
+                std::filesystem::path path;
+                unsigned int files; /// @brief Number of watched files in the directory.
+            };
+
+            std::unordered_map<std::string, Directory> directories; /// @brief Watched directories by normalized path.
+            std::unordered_map<int, std::string> watches;           /// @brief Watch descriptors to their directory.
+            std::unordered_map<std::string, std::filesystem::path> files;
+        };
+#endif
+    }
+
+    std::unique_ptr<FileWatcher> FileWatcher::Create()
+    {
+#ifdef __linux__
+        std::unique_ptr<InotifyFileWatcher> watcher = std::make_unique<InotifyFileWatcher>();
+        if (watcher->fd != -1)
+            return watcher;
+        std::cout << "[ERR] [INOTIFY_INIT_FAIL] errno " << errno << ", falling back to polling\n";
+#endif
+        return std::make_unique<PollingFileWatcher>();
+    }
+}
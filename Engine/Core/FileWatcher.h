@@ -0,0 +1,65 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace DT
+{
+    /**
+     * @brief Reports changes to a set of watched files. Implementations aren't thread safe, callers serialize access.
+     */
+    class FileWatcher
+    {
+    public:
+        virtual ~FileWatcher() = default;
+
+        /**
+         * @brief Starts reporting changes to a file, files replaced by renaming a new one over them keep being reported.
+         *
+         * @param path The file to watch.
+         */
+        virtual void Watch(const std::filesystem::path &path) = 0;
+
+        /**
+         * @brief Stops reporting changes to a file.
+         *
+         * @param path The file passed to Watch.
+         */
+        virtual void Unwatch(const std::filesystem::path &path) = 0;
+
+        /**
+         * @brief Collects the changes since the last call without blocking. A file written several times may be reported several times.
+         *
+         * @param changed Receives the paths of the changed files, as passed to Watch.
+         */
+        virtual void Poll(std::vector<std::filesystem::path> &changed) = 0;
+
+        /**
+         * @brief Creates the best watcher for the platform, inotify on Linux and timestamp polling elsewhere.
+         */
+        static std::unique_ptr<FileWatcher> Create();
+    };
+}
@@ -0,0 +1,178 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <iostream>
+#include <unordered_set>
+
+#include <Core/HotReloader.h>
+#include <Renderer/Renderer.h>
+#include <Renderer/Mesh.h>
+
+namespace DT
+{
+    HotReloader::HotReloader() : watcher(FileWatcher::Create())
+    {
+        // Scenes aren't reloaded in place, reloading one is what this avoids
+        Register<Texture>();
+        Register<Shader>();
+        Register<Material>();
+        Register<Mesh>();
+
+        thread = std::thread(&HotReloader::WatchLoop, this);
+    }
+
+    HotReloader::~HotReloader()
+    {
+        stopping = true;
+        thread.join();
+    }
+
+    void HotReloader::Update(ContextPtr &ctx)
+    {
+        SyncWatches(ctx);
+
+        std::vector<std::filesystem::path> changed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            watchDebounce = debounce;
+            changed.swap(settled);
+        }
+
+        if (!enabled)
+            return;
+
+        for (const std::filesystem::path &path : changed)
+        {
+            RID rid = ctx.resourceManager->FindRID(path);
+            if (rid == 0)
+                continue;
+
+            // A path may be cached as several types, reload each of them
+            for (auto &reload : reloaders)
+                reload(rid, ctx);
+        }
+    }
+
+    void HotReloader::WatchLoop()
+    {
+        std::unordered_map<std::string, std::pair<std::filesystem::path, Clock::time_point>> pending;
+        std::vector<std::filesystem::path> changed;
+
+        while (!stopping)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            watcher->Poll(changed);
+
+            Clock::time_point now = Clock::now();
+            for (std::filesystem::path &path : changed)
+                pending[path.generic_string()] = {std::move(path), now};
+            changed.clear();
+
+            for (auto it = pending.begin(); it != pending.end();)
+            {
+                if (std::chrono::duration<float, std::milli>(now - it->second.second).count() < watchDebounce)
+                {
+                    ++it;
+                    continue;
+                }
+                settled.push_back(std::move(it->second.first));
+                it = pending.erase(it);
+            }
+        }
+    }
+
+    void HotReloader::SyncWatches(ContextPtr &ctx)
+    {
+        // A released RID reused for another file leaves the size alone, the generation changes with every edit
+        unsigned int generation = ctx.resourceManager->GetGeneration();
+        if (generation == watchedGeneration)
+            return;
+        watchedGeneration = generation;
+
+        std::unordered_map<RID, std::filesystem::path> &resourceMap = ctx.resourceManager->resourceMap;
+
+        std::unordered_set<std::string> current;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &[rid, path] : resourceMap)
+        {
+            std::string key = path.generic_string();
+            current.insert(key);
+            if (watched.count(key))
+                continue;
+
+            // Packed resources have no file to watch
+            if (std::filesystem::is_regular_file(path))
+                watcher->Watch(path);
+            watched.emplace(std::move(key), path);
+        }
+
+        for (auto it = watched.begin(); it != watched.end();)
+        {
+            if (current.count(it->first))
+            {
+                ++it;
+                continue;
+            }
+            watcher->Unwatch(it->second);
+            it = watched.erase(it);
+        }
+    }
+
+    void HotReloader::Propagate(std::type_index type, RID rid, ContextPtr &ctx)
+    {
+        // Dependents point at the reloaded resource, which was replaced in place, so they already see the new data.
+        // Only what they derived from it has to be refreshed.
+        unsigned int dependents = 0;
+        if (type == typeid(Texture) || type == typeid(Shader))
+        {
+            ResourceCache::ForEach<Material>([&](RID, Material *material)
+                                             {
+                                                 if (type == typeid(Shader) && material->shader.rid == rid)
+                                                 {
+                                                     // The relinked program may lay its uniforms out differently
+                                                     material->InvalidateUniforms();
+                                                     dependents++;
+                                                 }
+                                                 else if (type == typeid(Texture) && material->texture.rid == rid)
+                                                     dependents++; });
+        }
+        else if (type == typeid(Material))
+        {
+            ResourceCache::ForEach<Mesh>([&](RID, Mesh *mesh)
+                                         {
+                                             for (Resource<Material> &material : mesh->materials)
+                                                 if (material.rid == rid)
+                                                 {
+                                                     dependents++;
+                                                     break;
+                                                 } });
+        }
+
+        // The old GL objects are gone, the renderer must not skip binding their replacements
+        ctx.renderer->InvalidateStateCache();
+        reloadCount++;
+
+        std::cout << "[LOG] Reloaded " << ctx.resourceManager->GetPath(rid).string() << ", " << dependents << " dependents updated\n";
+    }
+}
@@ -0,0 +1,107 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <Core/FileWatcher.h>
+#include <Core/ResourceManager.h>
+#include <Core/ResourceLoader.h>
+#include <Core/ResourceCache.h>
+#include <Core/ContextPtr.h>
+
+namespace DT
+{
+    /**
+     * @brief Watches the files of registered resources and reloads the cached resources whose file changed.
+     *
+     * A background thread collects changes and waits until a file stopped changing for debounce milliseconds, since
+     * editors often save in several writes. Update then rereads only the affected resources on the ResourceLoader's
+     * workers and replaces them in place, so whatever references them picks the new data up.
+     */
+    class HotReloader
+    {
+    public:
+        bool enabled = true;    /// @brief Whether changed files are reloaded, changes made while disabled are dropped.
+        float debounce = 150.f; /// @brief Milliseconds a file has to stay unchanged before it is reloaded.
+
+        HotReloader();
+        ~HotReloader();
+
+        /**
+         * @brief Makes cached resources of a type reloadable.
+         *
+         * @tparam T The resource type, must be split into ReadResource and UploadResource.
+         */
+        template <typename T>
+        void Register()
+        {
+            reloaders.push_back([this](RID rid, ContextPtr &ctx)
+                                {
+                                    if (ResourceCache::Find<T>(rid) == nullptr)
+                                        return false;
+                                    ctx.resourceLoader->Reload<T>(rid, ctx, [this, rid](ContextPtr &ctx)
+                                                                  { Propagate(typeid(T), rid, ctx); });
+                                    return true; });
+        }
+
+        /**
+         * @brief Watches newly registered resources and starts reloading the ones whose file settled. Called once per frame by the Engine.
+         */
+        void Update(ContextPtr &ctx);
+
+        size_t GetWatchedCount() const { return watched.size(); } /// @brief Number of watched resource files.
+        unsigned int GetReloadCount() const { return reloadCount; } /// @brief Number of resources reloaded since startup.
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::unique_ptr<FileWatcher> watcher;
+        std::vector<std::function<bool(RID, ContextPtr &)>> reloaders; /// @brief One per registered type, false if the resource isn't cached as that type.
+
+        std::mutex mutex; // Guards watcher, settled and watchDebounce, shared with the watch thread
+        std::vector<std::filesystem::path> settled; /// @brief Changed files that stopped changing, waiting for Update.
+        float watchDebounce = 150.f;                /// @brief Copy of debounce read by the watch thread.
+
+        std::thread thread;
+        std::atomic<bool> stopping{false};
+
+        std::unordered_map<std::string, std::filesystem::path> watched; /// @brief Watched files keyed by the path from resourceMap.
+        unsigned int watchedGeneration = 0;                             /// @brief ResourceManager generation as of the last sync, 0 before the first.
+        unsigned int reloadCount = 0;
+
+        void WatchLoop();
+        void SyncWatches(ContextPtr &ctx);
+        void Propagate(std::type_index type, RID rid, ContextPtr &ctx);
+    };
+}
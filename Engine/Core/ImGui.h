@@ -78,7 +78,8 @@ namespace ImGui
 
         if (fileDialog.HasSelected())
         {
-            resource->rid = ctx.resourceManager->GetRID(fileDialog.GetSelected());
+            // Through Load so the reference on the old entry is dropped before the new one is taken
+            resource->Load(ctx.resourceManager->GetRID(fileDialog.GetSelected()), ctx);
             fileDialog.ClearSelected();
         }
 
@@ -0,0 +1,190 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include <Core/JobSystem.h>
+
+namespace DT
+{
+    namespace
+    {
+        // The pool and deque of the worker running on this thread
+        thread_local JobSystem *currentSystem = nullptr;
+        thread_local unsigned int currentQueue = 0;
+    }
+
+    JobSystem::JobSystem(unsigned int workerCount)
+    {
+        for (unsigned int i = 0; i <= workerCount; i++)
+            queues.push_back(std::make_unique<Queue>());
+        for (unsigned int i = 0; i < workerCount; i++)
+            workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+        std::cout << "[LOG] JobSystem started " << workerCount << " workers\n";
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    void JobSystem::Submit(Job job, Counter *counter, Counter *dependency)
+    {
+        if (counter)
+        {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+            job = [this, job = std::move(job), counter]()
+            {
+                job();
+                Release(*counter);
+            };
+        }
+
+        if (dependency)
+        {
+            std::lock_guard<std::mutex> lock(dependency->mutex);
+            if (!dependency->IsDone())
+            {
+                dependency->continuations.push_back(std::move(job));
+                return;
+            }
+        }
+
+        Push(std::move(job));
+    }
+
+    void JobSystem::Push(Job job)
+    {
+        Queue &queue = *queues[GetQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        queued.fetch_add(1, std::memory_order_release);
+
+        // Taking the lock orders this with a worker checking queued right before it sleeps
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        jobAvailable.notify_one();
+    }
+
+    void JobSystem::Wait(Counter &counter)
+    {
+        while (!counter.IsDone())
+            if (!RunPendingJob())
+                std::this_thread::yield();
+
+        // The last job may still be releasing the counter, the caller is free to destroy it once it let go
+        std::lock_guard<std::mutex> lock(counter.mutex);
+    }
+
+    void JobSystem::Release(Counter &counter)
+    {
+        std::vector<Job> continuations;
+        {
+            std::lock_guard<std::mutex> lock(counter.mutex);
+            if (counter.value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            continuations.swap(counter.continuations);
+        }
+
+        for (Job &job : continuations)
+            Push(std::move(job));
+    }
+
+    bool JobSystem::RunPendingJob()
+    {
+        unsigned int index = GetQueueIndex();
+
+        Job job;
+        if (!Pop(index, job) && !Steal(index, job))
+            return false;
+
+        job();
+        return true;
+    }
+
+    unsigned int JobSystem::GetQueueIndex() const
+    {
+        return currentSystem == this ? currentQueue : (unsigned int)workers.size();
+    }
+
+    bool JobSystem::Pop(unsigned int index, Job &job)
+    {
+        Queue &queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            return false;
+
+        // Newest first, its data is most likely still in this core's cache
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool JobSystem::Steal(unsigned int index, Job &job)
+    {
+        for (size_t offset = 1; offset < queues.size(); offset++)
+        {
+            Queue &queue = *queues[(index + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty())
+                continue;
+
+            // Oldest first, usually the biggest piece of work left and the one its owner touches last
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::WorkerLoop(unsigned int index)
+    {
+        currentSystem = this;
+        currentQueue = index;
+
+        while (true)
+        {
+            if (RunPendingJob())
+                continue;
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            jobAvailable.wait(lock, [this]()
+                              { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping)
+                return;
+        }
+    }
+}
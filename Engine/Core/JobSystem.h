@@ -0,0 +1,164 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DT
+{
+    /**
+     * @brief Runs small jobs on a pool of worker threads.
+     *
+     * Every worker owns a deque it pushes to and pops from at the back, idle workers steal from the front of the
+     * others'. Jobs submitted from outside the pool go to a shared deque the workers steal from as well. Waiting on a
+     * Counter runs queued jobs instead of blocking, so jobs may wait on the jobs they submitted. Jobs that depend on
+     * others are held back until those finished rather than waiting inside a worker.
+     */
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Counts the unfinished jobs submitted with it and holds the jobs depending on them.
+         */
+        class Counter
+        {
+        public:
+            bool IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+        private:
+            std::atomic<unsigned int> value{0};
+            std::mutex mutex;               // Orders the last decrement with queuing continuations
+            std::vector<Job> continuations; /// @brief Jobs submitted to run once the counter reaches zero.
+
+            friend class JobSystem;
+        };
+
+        /**
+         * @param workerCount Number of worker threads, with none every job runs on the waiting thread.
+         */
+        JobSystem(unsigned int workerCount = GetDefaultWorkerCount());
+        ~JobSystem();
+
+        /**
+         * @brief Queues a job, on the calling worker's own deque if it is one.
+         *
+         * @param job The job to run.
+         * @param counter Incremented now and decremented once the job ran, may be nullptr.
+         * @param dependency The job is only queued once every job submitted with this counter finished, may be nullptr.
+         */
+        void Submit(Job job, Counter *counter = nullptr, Counter *dependency = nullptr);
+
+        /**
+         * @brief Runs queued jobs on the calling thread until every job submitted with the counter finished.
+         */
+        void Wait(Counter &counter);
+
+        /**
+         * @brief Runs one queued job on the calling thread.
+         *
+         * @return False if there was nothing to run.
+         */
+        bool RunPendingJob();
+
+        /**
+         * @brief Calls function(begin, end) for ranges covering [0, count) on the workers and the calling thread and
+         * returns once all of them finished.
+         *
+         * @param grain Indices per range, 0 splits the work into a few ranges per thread.
+         */
+        template <typename F>
+        void ParallelFor(size_t count, F &&function, size_t grain = 0)
+        {
+            if (count == 0)
+                return;
+            if (grain == 0)
+                grain = std::max<size_t>(count / ((workers.size() + 1) * 4), 1);
+
+            Counter counter;
+            for (size_t begin = grain; begin < count; begin += grain)
+                Submit([&function, begin, end = std::min(begin + grain, count)]()
+                       { function(begin, end); },
+                       &counter);
+
+            // The first range is ours, then help with the rest
+            function(0, std::min(grain, count));
+            Wait(counter);
+        }
+
+        /**
+         * @brief Calls function(entity) for every entity of an entt view on the workers and the calling thread and
+         * returns once all of them finished. The function may only touch the components of the entity it is given,
+         * and nothing may add or remove the components of the view meanwhile.
+         *
+         * @param grain Entities per job, 0 splits the view into a few jobs per thread.
+         */
+        template <typename View, typename F>
+        void ParallelForEach(const View &view, F &&function, size_t grain = 0)
+        {
+            // Split the leading storage of the view, the others are only checked for the entities it holds
+            const auto &entities = view.handle();
+            ParallelFor(
+                entities.size(), [&](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; i++)
+                        if (auto entity = entities.data()[i]; view.contains(entity))
+                            function(entity); },
+                grain);
+        }
+
+        static unsigned int GetDefaultWorkerCount() { return std::max(std::thread::hardware_concurrency(), 2u) - 1; } /// @brief One worker per hardware thread besides the main thread.
+        unsigned int GetWorkerCount() const { return (unsigned int)workers.size(); } /// @brief Number of worker threads, the waiting thread comes on top.
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues; /// @brief One per worker, the last one takes the jobs submitted from outside.
+        std::vector<std::thread> workers;
+
+        std::mutex sleepMutex;
+        std::condition_variable jobAvailable;
+        std::atomic<int> queued{0}; /// @brief Jobs in all deques, briefly off by the jobs being pushed.
+        std::atomic<bool> stopping{false};
+
+        unsigned int GetQueueIndex() const;
+        void Push(Job job);
+        void Release(Counter &counter);
+        bool Pop(unsigned int index, Job &job);
+        bool Steal(unsigned int index, Job &job);
+        void WorkerLoop(unsigned int index);
+    };
+}
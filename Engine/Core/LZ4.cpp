@@ -0,0 +1,238 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <Core/LZ4.h>
+
+namespace DT
+{
+    namespace
+    {
+        constexpr size_t minMatch = 4;
+        constexpr size_t lastLiterals = 5;    // Blocks always end with at least this many literals
+        constexpr size_t matchFindLimit = 12; // No match starts within this many bytes of the end
+        constexpr size_t maxDistance = 65535;
+        constexpr unsigned int hashBits = 16;
+        constexpr unsigned int maxChainAttempts = 256;
+
+        uint32_t Read32(const uint8_t *data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint32_t Hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - hashBits);
+        }
+
+        size_t MatchLength(const uint8_t *match, const uint8_t *position, const uint8_t *limit)
+        {
+            const uint8_t *start = position;
+            while (position < limit && *match == *position)
+            {
+                match++;
+                position++;
+            }
+            return position - start;
+        }
+
+        uint8_t *WriteLength(uint8_t *out, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                *out++ = 255;
+            *out++ = static_cast<uint8_t>(length);
+            return out;
+        }
+
+        /**
+         * @brief writes one sequence, a run of literals followed by a match, the last sequence has no match
+         */
+        uint8_t *WriteSequence(uint8_t *out, const uint8_t *literals, size_t literalLength, size_t offset, size_t matchLength)
+        {
+            uint8_t *token = out++;
+            *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+            if (literalLength >= 15)
+                out = WriteLength(out, literalLength - 15);
+            if (literalLength > 0)
+                std::memcpy(out, literals, literalLength);
+            out += literalLength;
+
+            if (matchLength == 0)
+                return out;
+
+            *out++ = static_cast<uint8_t>(offset & 0xFF);
+            *out++ = static_cast<uint8_t>(offset >> 8);
+            size_t length = matchLength - minMatch;
+            *token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+            if (length >= 15)
+                out = WriteLength(out, length - 15);
+            return out;
+        }
+    }
+
+    size_t LZ4::Compress(const void *source, size_t sourceSize, void *destination, Level level)
+    {
+        const uint8_t *in = static_cast<const uint8_t *>(source);
+        const uint8_t *end = in + sourceSize;
+        uint8_t *out = static_cast<uint8_t *>(destination);
+        const uint8_t *anchor = in;
+
+        if (sourceSize > matchFindLimit)
+        {
+            const uint8_t *matchLimit = end - lastLiterals;
+            const uint8_t *searchEnd = end - matchFindLimit;
+
+            // Positions are kept as offsets from the start of the block, -1 for none
+            std::vector<int64_t> head(size_t(1) << hashBits, -1);
+            std::vector<int64_t> chain(level == Level::High ? maxDistance + 1 : 0);
+
+            auto insert = [&](const uint8_t *position)
+            {
+                int64_t offset = position - in;
+                uint32_t hash = Hash(Read32(position));
+                if (level == Level::High)
+                    chain[offset & maxDistance] = head[hash];
+                head[hash] = offset;
+            };
+
+            const uint8_t *position = in;
+            while (position < searchEnd)
+            {
+                int64_t offset = position - in;
+                const uint8_t *bestMatch = nullptr;
+                size_t bestLength = 0;
+
+                uint32_t sequence = Read32(position);
+                int64_t candidate = head[Hash(sequence)];
+                for (unsigned int attempt = 0; candidate >= 0 && offset - candidate <= (int64_t)maxDistance; attempt++)
+                {
+                    const uint8_t *match = in + candidate;
+                    if (Read32(match) == sequence)
+                    {
+                        size_t length = minMatch + MatchLength(match + minMatch, position + minMatch, matchLimit);
+                        if (length > bestLength)
+                        {
+                            bestMatch = match;
+                            bestLength = length;
+                        }
+                    }
+
+                    if (level == Level::Fast || attempt + 1 >= maxChainAttempts)
+                        break;
+                    candidate = chain[candidate & maxDistance];
+                }
+
+                insert(position);
+
+                if (bestMatch == nullptr)
+                {
+                    position++;
+                    continue;
+                }
+
+                out = WriteSequence(out, anchor, position - anchor, position - bestMatch, bestLength);
+
+                const uint8_t *matchEnd = position + bestLength;
+                if (level == Level::High)
+                    // Everything the match covers becomes a future candidate, the fast level skips it for speed
+                    for (position++; position < matchEnd && position < searchEnd; position++)
+                        insert(position);
+                position = matchEnd;
+                anchor = position;
+            }
+        }
+
+        out = WriteSequence(out, anchor, end - anchor, 0, 0);
+        return out - static_cast<uint8_t *>(destination);
+    }
+
+    bool LZ4::Decompress(const void *source, size_t sourceSize, void *destination, size_t destinationSize)
+    {
+        const uint8_t *in = static_cast<const uint8_t *>(source);
+        const uint8_t *inEnd = in + sourceSize;
+        uint8_t *outStart = static_cast<uint8_t *>(destination);
+        uint8_t *out = outStart;
+        uint8_t *outEnd = out + destinationSize;
+
+        auto readLength = [&](size_t &length)
+        {
+            uint8_t byte;
+            do
+            {
+                if (in >= inEnd)
+                    return false;
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (in < inEnd)
+        {
+            uint8_t token = *in++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(literalLength))
+                return false;
+            if ((size_t)(inEnd - in) < literalLength || (size_t)(outEnd - out) < literalLength)
+                return false;
+            if (literalLength > 0)
+                std::memcpy(out, in, literalLength);
+            in += literalLength;
+            out += literalLength;
+
+            // The last sequence ends with its literals
+            if (in == inEnd)
+                break;
+
+            if (inEnd - in < 2)
+                return false;
+            size_t offset = in[0] | (size_t(in[1]) << 8);
+            in += 2;
+            if (offset == 0 || offset > (size_t)(out - outStart))
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(matchLength))
+                return false;
+            matchLength += minMatch;
+            if ((size_t)(outEnd - out) < matchLength)
+                return false;
+
+            const uint8_t *match = out - offset;
+            if (offset >= matchLength)
+                std::memcpy(out, match, matchLength);
+            else
+                // Overlapping matches repeat the last offset bytes, copy forwards one byte at a time
+                for (size_t i = 0; i < matchLength; i++)
+                    out[i] = match[i];
+            out += matchLength;
+        }
+
+        return out == outEnd;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DT
+{
+    /**
+     * @brief LZ4 block codec used for pack blobs. Both levels write the standard LZ4 block format and share one decoder,
+     * the high level spends more time searching for matches to write smaller blocks for distribution builds.
+     */
+    namespace LZ4
+    {
+        enum class Level
+        {
+            Fast, /// @brief Greedy single probe matching, for quick iteration builds.
+            High  /// @brief Hash chain search for the longest match, several times slower to compress, as fast to decompress.
+        };
+
+        /**
+         * @brief largest compressed size of size bytes, the destination of Compress needs this much room
+         */
+        constexpr size_t CompressBound(size_t size)
+        {
+            return size + size / 255 + 16;
+        }
+
+        /**
+         * @brief compresses a block
+         * @param source data to compress
+         * @param sourceSize size of the data in bytes
+         * @param destination buffer of at least CompressBound(sourceSize) bytes
+         * @param level how hard to search for matches
+         * @return size of the compressed block in bytes
+         */
+        size_t Compress(const void *source, size_t sourceSize, void *destination, Level level);
+
+        /**
+         * @brief decompresses a block, every read and write is bounds checked so corrupt blocks fail instead of overrunning
+         * @param source compressed block
+         * @param sourceSize size of the compressed block in bytes
+         * @param destination buffer receiving the data
+         * @param destinationSize exact size of the decompressed data in bytes
+         * @return whether the block decompressed to exactly destinationSize bytes
+         */
+        bool Decompress(const void *source, size_t sourceSize, void *destination, size_t destinationSize);
+    }
+}
@@ -0,0 +1,474 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <Core/PackFile.h>
+#include <Core/LZ4.h>
+
+namespace DT
+{
+    uint64_t PackFile::Hash(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    std::string PackFile::NormalizePath(const std::filesystem::path &relativePath)
+    {
+        return relativePath.lexically_normal().generic_string();
+    }
+
+    std::vector<unsigned char> PackFile::CompressBlob(const void *data, size_t size, Compression compression)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        LZ4::Level level = compression == Compression::LZ4High ? LZ4::Level::High : LZ4::Level::Fast;
+
+        uint32_t chunkCount = static_cast<uint32_t>((size + chunkSize - 1) / chunkSize);
+        std::vector<unsigned char> blob(sizeof(uint32_t) * (chunkCount + 1));
+        std::memcpy(blob.data(), &chunkCount, sizeof(chunkCount));
+
+        std::vector<unsigned char> compressed(LZ4::CompressBound(chunkSize));
+        for (uint32_t i = 0; i < chunkCount; i++)
+        {
+            const unsigned char *chunk = bytes + (size_t)i * chunkSize;
+            size_t rawSize = std::min<size_t>(chunkSize, size - (size_t)i * chunkSize);
+            size_t compressedSize = LZ4::Compress(chunk, rawSize, compressed.data(), level);
+
+            uint32_t storedSize = static_cast<uint32_t>(compressedSize);
+            const unsigned char *stored = compressed.data();
+            if (compressedSize >= rawSize)
+            {
+                storedSize = static_cast<uint32_t>(rawSize) | storedChunk;
+                stored = chunk;
+                compressedSize = rawSize;
+            }
+
+            std::memcpy(blob.data() + sizeof(uint32_t) * (i + 1), &storedSize, sizeof(storedSize));
+            blob.insert(blob.end(), stored, stored + compressedSize);
+        }
+        return blob;
+    }
+
+    bool PackFile::Build(const ResourceManager &resources, const std::filesystem::path &root, const std::filesystem::path &output,
+                         Compression compression)
+    {
+        struct File
+        {
+            RID rid;
+            std::filesystem::path source;
+            std::string path;
+        };
+
+        std::filesystem::path absoluteRoot = std::filesystem::absolute(root).lexically_normal();
+        std::vector<File> files;
+        unsigned int skipped = 0;
+        for (const auto &[rid, path] : resources.resourceMap)
+        {
+            std::error_code error;
+            std::filesystem::path relative = std::filesystem::absolute(path).lexically_normal().lexically_relative(absoluteRoot);
+            if (relative.empty() || *relative.begin() == ".." || !std::filesystem::is_regular_file(path, error))
+            {
+                skipped++;
+                continue;
+            }
+            files.push_back({rid, path, NormalizePath(relative)});
+        }
+        std::sort(files.begin(), files.end(), [](const File &a, const File &b)
+                  { return a.rid < b.rid; });
+
+        Header header = {};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.entryCount = static_cast<uint32_t>(files.size());
+        header.entryOffset = sizeof(Header);
+        header.pathOffset = header.entryOffset + files.size() * sizeof(Entry);
+
+        std::string pathTable;
+        std::vector<Entry> entries(files.size());
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            entries[i].rid = files[i].rid;
+            entries[i].pathOffset = static_cast<uint32_t>(pathTable.size());
+            entries[i].pathSize = static_cast<uint32_t>(files[i].path.size());
+            pathTable += files[i].path;
+        }
+        header.pathSize = pathTable.size();
+        header.dataOffset = Align(header.pathOffset + header.pathSize);
+
+        // Written next to the output and renamed once complete, the old pack may still be mapped
+        std::filesystem::path temporary = output;
+        temporary += ".tmp";
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out)
+        {
+            std::cout << "[ERR] [PACK_WRITE_FAIL] [" << output.string() << "]\n";
+            return false;
+        }
+
+        uint64_t offset = header.dataOffset;
+        uint64_t rawBytes = 0;
+        std::unordered_map<uint64_t, size_t> blobs; // Content hash to the first entry storing it
+        out.seekp(offset);
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            std::ifstream in(files[i].source, std::ios::binary);
+            std::vector<char> contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+            Entry &entry = entries[i];
+            entry.compression = static_cast<uint32_t>(Compression::None);
+            entry.size = contents.size();
+            entry.rawSize = contents.size();
+            entry.hash = Hash(contents.data(), contents.size());
+
+            auto blob = blobs.find(entry.hash);
+            if (blob != blobs.end() && entries[blob->second].rawSize == entry.rawSize)
+            {
+                // Confirm the match, the hash alone could collide
+                std::ifstream first(files[blob->second].source, std::ios::binary);
+                std::vector<char> firstContents((std::istreambuf_iterator<char>(first)), std::istreambuf_iterator<char>());
+                if (firstContents == contents)
+                {
+                    entry.offset = entries[blob->second].offset;
+                    entry.size = entries[blob->second].size;
+                    entry.compression = entries[blob->second].compression;
+                    continue;
+                }
+            }
+            else
+                blobs.emplace(entry.hash, i);
+
+            const char *stored = contents.data();
+            std::vector<unsigned char> compressed;
+            if (compression != Compression::None)
+            {
+                compressed = CompressBlob(contents.data(), contents.size(), compression);
+                // Blobs that barely shrink (already compressed images and the like) stay in place in the mapping
+                if (compressed.size() < contents.size() - contents.size() / 16)
+                {
+                    entry.compression = static_cast<uint32_t>(compression);
+                    entry.size = compressed.size();
+                    stored = reinterpret_cast<const char *>(compressed.data());
+                }
+            }
+
+            uint64_t aligned = Align(offset);
+            out.write(std::string(aligned - offset, '\0').data(), aligned - offset);
+            entry.offset = aligned;
+            out.write(stored, entry.size);
+            offset = aligned + entry.size;
+            rawBytes += entry.rawSize;
+        }
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Entry));
+        out.write(pathTable.data(), pathTable.size());
+        out.close();
+
+        std::error_code error;
+        if (out.fail() || (std::filesystem::rename(temporary, output, error), error))
+        {
+            std::cout << "[ERR] [PACK_WRITE_FAIL] [" << output.string() << "]\n";
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+
+        std::cout << "[LOG] Packed " << files.size() << " files (" << blobs.size() << " unique, " << skipped << " missing or outside of "
+                  << root.string() << " skipped) into " << output.string() << ", " << offset / 1048576.f << " MB holding "
+                  << rawBytes / 1048576.f << " MB of files\n";
+        return true;
+    }
+
+    bool PackArchive::Open(const std::filesystem::path &path)
+    {
+        file = std::make_shared<Platform::MappedFile>();
+        if (!file->Open(path))
+            return false;
+
+        PackFile::Header header;
+        if (file->size < sizeof(header))
+        {
+            std::cout << "[ERR] [PACK_CORRUPT] [" << path.string() << "]\n";
+            return false;
+        }
+        std::memcpy(&header, file->data, sizeof(header));
+
+        if (std::memcmp(header.magic, PackFile::magic, sizeof(PackFile::magic)) != 0 || header.version != PackFile::version)
+        {
+            std::cout << "[ERR] [PACK_VERSION_MISMATCH] [" << path.string() << "] Rebuild the pack.\n";
+            return false;
+        }
+
+        if (header.entryOffset % alignof(PackFile::Entry) != 0 ||
+            header.entryOffset + (uint64_t)header.entryCount * sizeof(PackFile::Entry) > file->size ||
+            header.pathOffset + header.pathSize > file->size)
+        {
+            std::cout << "[ERR] [PACK_CORRUPT] [" << path.string() << "]\n";
+            return false;
+        }
+
+        entries = reinterpret_cast<const PackFile::Entry *>(file->data + header.entryOffset);
+        entryCount = header.entryCount;
+        paths = reinterpret_cast<const char *>(file->data + header.pathOffset);
+
+        pathIndex.clear();
+        pathIndex.reserve(entryCount);
+        for (uint32_t i = 0; i < entryCount; i++)
+        {
+            const PackFile::Entry &entry = entries[i];
+            if ((uint64_t)entry.pathOffset + entry.pathSize > header.pathSize || entry.offset + entry.size > file->size)
+            {
+                std::cout << "[ERR] [PACK_CORRUPT] [" << path.string() << "]\n";
+                return false;
+            }
+            pathIndex.emplace(std::string(paths + entry.pathOffset, entry.pathSize), &entry);
+        }
+
+        return true;
+    }
+
+    const PackFile::Entry *PackArchive::Find(RID rid) const
+    {
+        const PackFile::Entry *end = entries + entryCount;
+        const PackFile::Entry *entry = std::lower_bound(entries, end, rid, [](const PackFile::Entry &entry, RID rid)
+                                                        { return entry.rid < rid; });
+        return entry != end && entry->rid == rid ? entry : nullptr;
+    }
+
+    const PackFile::Entry *PackArchive::Find(const std::filesystem::path &relativePath) const
+    {
+        auto it = pathIndex.find(PackFile::NormalizePath(relativePath));
+        return it == pathIndex.end() ? nullptr : it->second;
+    }
+
+    std::filesystem::path PackArchive::GetPath(const PackFile::Entry &entry) const
+    {
+        return std::filesystem::path(std::string(paths + entry.pathOffset, entry.pathSize));
+    }
+
+    FileView PackArchive::Read(const PackFile::Entry &entry) const
+    {
+        FileView view;
+        switch (static_cast<PackFile::Compression>(entry.compression))
+        {
+        case PackFile::Compression::None:
+            view.data = entry.size > 0 ? file->data + entry.offset : nullptr;
+            view.size = entry.size;
+            view.owner = file;
+            return view;
+
+        case PackFile::Compression::LZ4:
+        case PackFile::Compression::LZ4High:
+        {
+            std::shared_ptr<std::vector<unsigned char>> buffer = std::make_shared<std::vector<unsigned char>>(entry.rawSize);
+            PackStream stream = OpenStream(entry);
+            if (stream.Read(buffer->data(), buffer->size()) != buffer->size())
+            {
+                std::cout << "[ERR] [PACK_CORRUPT] [" << GetPath(entry).string() << "]\n";
+                return FileView();
+            }
+
+            view.data = buffer->empty() ? nullptr : buffer->data();
+            view.size = buffer->size();
+            view.owner = buffer;
+            return view;
+        }
+
+        default:
+            std::cout << "[ERR] [PACK_UNKNOWN_COMPRESSION] [" << GetPath(entry).string() << "]\n";
+            return FileView();
+        }
+    }
+
+    PackStream PackArchive::OpenStream(const PackFile::Entry &entry) const
+    {
+        PackStream stream(file->data + entry.offset, entry);
+        stream.owner = file;
+        return stream;
+    }
+
+    PackStream::PackStream(const unsigned char *blob, const PackFile::Entry &entry) : blob(blob), entry(entry)
+    {
+        if (static_cast<PackFile::Compression>(entry.compression) == PackFile::Compression::None)
+            return;
+
+        if (entry.size < sizeof(uint32_t))
+        {
+            failed = true;
+            return;
+        }
+
+        std::memcpy(&chunkCount, blob, sizeof(chunkCount));
+        uint64_t tableSize = sizeof(uint32_t) * ((uint64_t)chunkCount + 1);
+        if (tableSize > entry.size || chunkCount != (entry.rawSize + PackFile::chunkSize - 1) / PackFile::chunkSize)
+        {
+            failed = true;
+            return;
+        }
+
+        chunkSizes = reinterpret_cast<const uint32_t *>(blob + sizeof(uint32_t));
+        nextChunk = blob + tableSize;
+    }
+
+    size_t PackStream::Read(void *destination, size_t size)
+    {
+        if (failed)
+            return 0;
+
+        unsigned char *out = static_cast<unsigned char *>(destination);
+        size = std::min(size, GetSize() - position);
+
+        if (static_cast<PackFile::Compression>(entry.compression) == PackFile::Compression::None)
+        {
+            if (size > 0)
+                std::memcpy(out, blob + position, size);
+            position += size;
+            return size;
+        }
+
+        size_t read = 0;
+        while (read < size)
+        {
+            // The rest of a chunk a previous read only took part of
+            if (bufferPosition < buffer.size())
+            {
+                size_t count = std::min(size - read, buffer.size() - bufferPosition);
+                std::memcpy(out + read, buffer.data() + bufferPosition, count);
+                bufferPosition += count;
+                read += count;
+                continue;
+            }
+
+            size_t rawSize = static_cast<size_t>(std::min<uint64_t>(PackFile::chunkSize, entry.rawSize - (uint64_t)chunk * PackFile::chunkSize));
+            if (size - read >= rawSize)
+            {
+                if (!DecompressChunk(out + read, rawSize))
+                    break;
+                read += rawSize;
+            }
+            else
+            {
+                buffer.resize(rawSize);
+                bufferPosition = 0;
+                if (!DecompressChunk(buffer.data(), rawSize))
+                {
+                    buffer.clear();
+                    break;
+                }
+            }
+        }
+
+        position += read;
+        return read;
+    }
+
+    bool PackStream::Seek(size_t target)
+    {
+        if (failed || target > GetSize())
+            return false;
+
+        buffer.clear();
+        bufferPosition = 0;
+        if (static_cast<PackFile::Compression>(entry.compression) == PackFile::Compression::None)
+        {
+            position = target;
+            return true;
+        }
+
+        // Walk the size table up to the chunk holding target, the chunks follow the table back to back
+        uint32_t targetChunk = static_cast<uint32_t>(target / PackFile::chunkSize);
+        uint64_t offset = sizeof(uint32_t) * ((uint64_t)chunkCount + 1);
+        for (uint32_t i = 0; i < targetChunk; i++)
+            offset += chunkSizes[i] & ~PackFile::storedChunk;
+        if (offset > entry.size)
+        {
+            failed = true;
+            return false;
+        }
+
+        nextChunk = blob + offset;
+        chunk = targetChunk;
+        position = (size_t)targetChunk * PackFile::chunkSize;
+
+        // Partway into the chunk, the part before target is dropped by the next Read
+        if (target > position)
+        {
+            size_t rawSize = static_cast<size_t>(std::min<uint64_t>(PackFile::chunkSize, entry.rawSize - position));
+            buffer.resize(rawSize);
+            if (!DecompressChunk(buffer.data(), rawSize))
+            {
+                buffer.clear();
+                return false;
+            }
+            bufferPosition = target - position;
+            position = target;
+        }
+        return true;
+    }
+
+    bool PackStream::DecompressChunk(unsigned char *destination, size_t rawSize)
+    {
+        const unsigned char *end = blob + entry.size;
+        if (chunk >= chunkCount)
+        {
+            failed = true;
+            return false;
+        }
+
+        uint32_t storedSize = chunkSizes[chunk];
+        size_t size = storedSize & ~PackFile::storedChunk;
+        bool decompressed = false;
+        if (size <= (size_t)(end - nextChunk))
+        {
+            if (storedSize & PackFile::storedChunk)
+            {
+                decompressed = size == rawSize;
+                if (decompressed)
+                    std::memcpy(destination, nextChunk, size);
+            }
+            else
+                decompressed = LZ4::Decompress(nextChunk, size, destination, rawSize);
+        }
+
+        if (!decompressed)
+        {
+            failed = true;
+            return false;
+        }
+
+        nextChunk += size;
+        chunk++;
+        return true;
+    }
+}
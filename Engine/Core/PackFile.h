@@ -0,0 +1,244 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Core/ResourceManager.h>
+#include <Core/VirtualFileSystem.h>
+#include <Core/Platform.h>
+
+namespace DT
+{
+    /**
+     * @brief Asset archive (.dtpack) bundling the loose resource files of a project so they're read with a few large
+     * sequential reads instead of thousands of opens.
+     *
+     * Layout: Header, the Entry table sorted by RID, the path table and then the blobs, each blob starting on an
+     * alignment boundary. Paths are stored relative to the directory the pack was built from, identical files share
+     * one blob. Offsets are measured from the start of the file, everything is little endian.
+     *
+     * Compressed blobs are split into chunks of chunkSize bytes compressed independently, so they can be decompressed
+     * in order straight into their destination. They start with the chunk count and a table of the compressed chunk
+     * sizes, followed by the chunks back to back. Chunks compression didn't shrink are stored as they are.
+     */
+    namespace PackFile
+    {
+        constexpr char magic[4] = {'D', 'T', 'P', 'K'}; /// @brief First four bytes of every pack.
+        constexpr uint32_t version = 1;                  /// @brief Bumped whenever the layout changes, older packs have to be rebuilt.
+        constexpr uint64_t alignment = 16;               /// @brief Alignment of every blob in the file.
+        constexpr const char *fileName = "Assets.dtpack"; /// @brief Name of the pack mounted next to the project file.
+        constexpr uint32_t chunkSize = 256 << 10;         /// @brief Uncompressed size of every chunk of a compressed blob but the last.
+        constexpr uint32_t storedChunk = 0x80000000u;     /// @brief Set in a chunk's size when the chunk isn't compressed.
+
+        /**
+         * @brief How a blob is stored.
+         */
+        enum class Compression : uint32_t
+        {
+            None = 0,   /// @brief Stored as is, served straight from the mapping.
+            LZ4 = 1,    /// @brief LZ4 chunks compressed with LZ4::Level::Fast, for quick iteration builds.
+            LZ4High = 2 /// @brief LZ4 chunks compressed with LZ4::Level::High, for distribution builds.
+        };
+
+        struct Header
+        {
+            char magic[4];        /// @brief Always PackFile::magic.
+            uint32_t version;     /// @brief PackFile::version the pack was written with.
+            uint32_t entryCount;  /// @brief Number of entries in the entry table.
+            uint32_t padding;     /// @brief Keeps the offsets 8 byte aligned, always 0.
+            uint64_t entryOffset; /// @brief Offset of the entry table.
+            uint64_t pathOffset;  /// @brief Offset of the path table.
+            uint64_t pathSize;    /// @brief Size of the path table in bytes.
+            uint64_t dataOffset;  /// @brief Offset of the first blob.
+        };
+
+        struct Entry
+        {
+            RID rid;              /// @brief Resource ID the file had in the project the pack was built from.
+            uint32_t compression; /// @brief Compression of the blob.
+            uint64_t offset;      /// @brief Offset of the blob.
+            uint64_t size;        /// @brief Size of the blob as stored.
+            uint64_t rawSize;     /// @brief Size of the file once decompressed.
+            uint64_t hash;        /// @brief Hash of the file contents, see PackFile::Hash.
+            uint32_t pathOffset;  /// @brief Offset of the path inside the path table.
+            uint32_t pathSize;    /// @brief Length of the path in bytes, not null terminated.
+        };
+
+        static_assert(sizeof(Header) == 48, "PackFile::Header layout changed");
+        static_assert(sizeof(Entry) == 48, "PackFile::Entry layout changed");
+
+        /**
+         * @brief rounds an offset up to the next alignment boundary
+         */
+        inline uint64_t Align(uint64_t offset)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief 64 bit FNV-1a hash of a blob
+         */
+        uint64_t Hash(const void *data, size_t size);
+
+        /**
+         * @brief the key a path is stored under in a pack
+         * @param relativePath path relative to the pack root
+         */
+        std::string NormalizePath(const std::filesystem::path &relativePath);
+
+        /**
+         * @brief packs every file of the resource manager found under root
+         * @param resources resource manager whose RIDs and paths are packed
+         * @param root directory the stored paths are relative to, files outside of it are skipped
+         * @param output path of the pack to write
+         * @param compression how to compress the blobs, blobs that barely shrink are stored uncompressed
+         * @return whether the pack was written
+         */
+        bool Build(const ResourceManager &resources, const std::filesystem::path &root, const std::filesystem::path &output,
+                   Compression compression = Compression::None);
+
+        /**
+         * @brief compresses a blob into the chunked layout
+         * @param data contents of the file
+         * @param size size of the contents in bytes
+         * @param compression LZ4 or LZ4High
+         * @return the compressed blob
+         */
+        std::vector<unsigned char> CompressBlob(const void *data, size_t size, Compression compression);
+    }
+
+    /**
+     * @brief Reads one blob of a pack in order, decompressing chunk by chunk straight into the caller's buffers.
+     */
+    class PackStream
+    {
+    public:
+        /**
+         * @brief Starts reading a blob.
+         *
+         * @param blob The blob as stored in the pack.
+         * @param entry The entry describing the blob.
+         */
+        PackStream(const unsigned char *blob, const PackFile::Entry &entry);
+
+        /**
+         * @brief Reads the next bytes of the file, chunks covered entirely are decompressed in place.
+         *
+         * @param destination Buffer receiving the bytes, a mapped GL buffer or a vector's storage for example.
+         * @param size Number of bytes to read.
+         * @return Number of bytes read, less than size at the end of the file or if the blob is corrupt.
+         */
+        size_t Read(void *destination, size_t size);
+
+        /**
+         * @brief Moves to another position of the file. Chunks are compressed independently, so only the chunk
+         * holding the position is decompressed, and only if the position falls inside it.
+         *
+         * @param target Position in the decompressed file.
+         * @return Whether the position is inside the file and its chunk could be read.
+         */
+        bool Seek(size_t target);
+
+        std::shared_ptr<const void> owner; /// @brief Keeps the blob alive, set to the pack mapping by PackArchive::OpenStream.
+
+        size_t GetSize() const { return static_cast<size_t>(entry.rawSize); } /// @brief Size of the file once decompressed.
+        size_t Tell() const { return position; }                              /// @brief Number of bytes read so far.
+        bool HasFailed() const { return failed; }                            /// @brief Whether the blob turned out corrupt.
+
+    private:
+        const unsigned char *blob;
+        PackFile::Entry entry;
+        uint32_t chunkCount = 0;
+        const uint32_t *chunkSizes = nullptr;
+        const unsigned char *nextChunk = nullptr; /// @brief Compressed data of the chunk after the current one.
+        uint32_t chunk = 0;                       /// @brief Index of the next chunk to decompress.
+        std::vector<unsigned char> buffer;        /// @brief Current chunk when only part of it was requested.
+        size_t bufferPosition = 0;
+        size_t position = 0;
+        bool failed = false;
+
+        bool DecompressChunk(unsigned char *destination, size_t rawSize);
+    };
+
+    /**
+     * @brief A memory mapped pack, uncompressed blobs are handed out in place without being copied.
+     */
+    class PackArchive
+    {
+    public:
+        /**
+         * @brief Maps a pack and indexes its paths.
+         *
+         * @param path The pack to open.
+         * @return Whether the pack is valid.
+         */
+        bool Open(const std::filesystem::path &path);
+
+        /**
+         * @brief Looks an entry up by the RID it was packed with.
+         *
+         * @return The entry, nullptr if the pack doesn't hold the RID.
+         */
+        const PackFile::Entry *Find(RID rid) const;
+
+        /**
+         * @brief Looks an entry up by its path relative to the pack root.
+         *
+         * @return The entry, nullptr if the pack doesn't hold the path.
+         */
+        const PackFile::Entry *Find(const std::filesystem::path &relativePath) const;
+
+        /**
+         * @brief The path of an entry relative to the pack root.
+         */
+        std::filesystem::path GetPath(const PackFile::Entry &entry) const;
+
+        /**
+         * @brief The contents of an entry. Uncompressed blobs share ownership of the pack mapping, compressed ones are
+         * decompressed into a buffer of their own.
+         */
+        FileView Read(const PackFile::Entry &entry) const;
+
+        /**
+         * @brief Streams the contents of an entry, for callers decompressing into a destination of their own. The
+         * stream reads the mapping directly and shares its ownership.
+         */
+        PackStream OpenStream(const PackFile::Entry &entry) const;
+
+        uint32_t GetEntryCount() const { return entryCount; }                                 /// @brief Number of entries in the pack.
+        const PackFile::Entry &GetEntry(uint32_t index) const { return entries[index]; } /// @brief Entry by index, sorted by RID.
+
+    private:
+        std::shared_ptr<Platform::MappedFile> file;
+        const PackFile::Entry *entries = nullptr;
+        uint32_t entryCount = 0;
+        const char *paths = nullptr;
+        std::unordered_map<std::string, const PackFile::Entry *> pathIndex;
+    };
+}
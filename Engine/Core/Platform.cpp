@@ -22,6 +22,13 @@ aryanbaburajan2007@gmail.com
 
 #include <iostream>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <Core/Platform.h>
 
 namespace DT
@@ -60,6 +67,89 @@ namespace DT
 #endif
         }
 
+        Platform::MappedFile::~MappedFile()
+        {
+                Close();
+        }
+
+        bool Platform::MappedFile::Open(const std::filesystem::path &path)
+        {
+                Close();
+
+#ifdef _WIN32
+                file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (file == INVALID_HANDLE_VALUE)
+                {
+                        std::cout << "[ERR] [MAP_FAIL] [" << path.string() << "] " << GetLastErrorAsString();
+                        return false;
+                }
+
+                LARGE_INTEGER fileSize;
+                GetFileSizeEx(file, &fileSize);
+                size = static_cast<size_t>(fileSize.QuadPart);
+
+                // Empty files cannot be mapped
+                if (size == 0)
+                        return true;
+
+                mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping != NULL)
+                        data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#endif
+#ifdef __linux__
+                int file = open(path.c_str(), O_RDONLY);
+                if (file == -1)
+                {
+                        std::cout << "[ERR] [MAP_FAIL] [" << path.string() << "]\n";
+                        return false;
+                }
+
+                struct stat fileStat;
+                fstat(file, &fileStat);
+                size = static_cast<size_t>(fileStat.st_size);
+
+                if (size == 0)
+                {
+                        close(file);
+                        return true;
+                }
+
+                void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+                close(file); // The mapping keeps its own reference to the file
+                if (mapped != MAP_FAILED)
+                        data = static_cast<const unsigned char *>(mapped);
+#endif
+
+                if (data == nullptr)
+                {
+                        std::cout << "[ERR] [MAP_FAIL] [" << path.string() << "]\n";
+                        Close();
+                        return false;
+                }
+
+                return true;
+        }
+
+        void Platform::MappedFile::Close()
+        {
+#ifdef _WIN32
+                if (data != nullptr)
+                        UnmapViewOfFile(data);
+                if (mapping != NULL)
+                        CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE)
+                        CloseHandle(file);
+                mapping = NULL;
+                file = INVALID_HANDLE_VALUE;
+#endif
+#ifdef __linux__
+                if (data != nullptr)
+                        munmap(const_cast<unsigned char *>(data), size);
+#endif
+                data = nullptr;
+                size = 0;
+        }
+
         Platform::Module::~Module()
         {
                 Free();
@@ -24,6 +24,7 @@ aryanbaburajan2007@gmail.com
 
 #include <string>
 #include <filesystem>
+#include <cstddef>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -52,6 +53,44 @@ namespace DT
 		 */
 		void Execute(const std::string command);
 
+		/**
+		 * @brief A read-only memory mapping of a whole file.
+		 */
+		class MappedFile
+		{
+		public:
+			const unsigned char *data = nullptr; /**< Start of the mapping, nullptr if no file is open. */
+			size_t size = 0;					 /**< Size of the file in bytes. */
+
+			MappedFile() = default;
+			MappedFile(const MappedFile &) = delete;
+			MappedFile &operator=(const MappedFile &) = delete;
+
+			/**
+			 * @brief Destructor for the MappedFile class. Unmaps the file.
+			 */
+			~MappedFile();
+
+			/**
+			 * @brief Maps a file into memory.
+			 *
+			 * @param path The path to the file.
+			 * @return True if the file was mapped.
+			 */
+			bool Open(const std::filesystem::path &path);
+
+			/**
+			 * @brief Unmaps the file.
+			 */
+			void Close();
+
+		private:
+#ifdef _WIN32
+			HANDLE file = INVALID_HANDLE_VALUE;
+			HANDLE mapping = NULL;
+#endif
+		};
+
 		/**
 		 * @brief The Module class for loading and managing dynamic libraries.
 		 */
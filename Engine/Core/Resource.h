@@ -22,9 +22,13 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <chrono>
+#include <future>
 #include <iostream>
 
 #include <Core/ResourceManager.h>
+#include <Core/ResourceLoader.h>
+#include <Core/ResourceCache.h>
 #include <Core/Serialization.h>
 #include <Core/ContextPtr.h>
 
@@ -33,29 +37,58 @@ namespace DT
     /**
      * @brief The Resource class template for managing resources.
      *
+     * Handles holding loaded data reference its ResourceCache entry, the data stays loaded while any handle
+     * references it and becomes evictable afterwards.
+     *
      * @tparam T The resource type.
      */
     template <typename T>
     class Resource
     {
     public:
+        using Type = T; /// @brief The resource type.
+
         /**
          * @brief The resource ID.
          */
-        RID rid;
+        RID rid = 0;
 
         /**
          * @brief Pointer to the resource data.
          */
-        T *data;
+        T *data = nullptr;
+
+        Resource() = default;
+
+        Resource(const Resource &other) : rid(other.rid), pending(other.pending), pendingRid(other.pendingRid)
+        {
+            Attach(other.data, other.referenced ? other.referencedRid : other.rid);
+        }
+
+        Resource &operator=(const Resource &other)
+        {
+            if (this != &other)
+            {
+                Unload();
+                rid = other.rid;
+                pending = other.pending;
+                pendingRid = other.pendingRid;
+                Attach(other.data, other.referenced ? other.referencedRid : other.rid);
+            }
+            return *this;
+        }
+
+        ~Resource()
+        {
+            Unload();
+        }
 
         /**
-         * @brief Reloads the resource.
+         * @brief Rereads the resource in the background and replaces the cached copy in place, every handle sees the new data once it is uploaded.
          */
         void Reload(ContextPtr &ctx)
         {
-            data = nullptr;
-            Load(rid, ctx);
+            ctx.resourceLoader->Reload<T>(rid, ctx);
         }
 
         /**
@@ -65,10 +98,11 @@ namespace DT
          */
         void Load(RID loadRid, ContextPtr &ctx)
         {
+            Unload();
             rid = loadRid;
             try
             {
-                data = T::LoadResource(rid, ctx);
+                Attach(ResourceCache::Load<T>(rid, ctx), rid);
             }
             catch (json::exception &e)
             {
@@ -76,6 +110,42 @@ namespace DT
             }
         }
 
+        /**
+         * @brief Starts loading the resource with the specified resource ID in the background, data stays nullptr until IsReady.
+         *
+         * @param loadRid The resource ID to load.
+         * @return Future resolved once the resource is uploaded.
+         */
+        std::shared_future<T *> LoadAsync(RID loadRid, ContextPtr &ctx)
+        {
+            Unload();
+            rid = loadRid;
+            pendingRid = rid;
+            pending = ctx.resourceLoader->LoadAsync<T>(rid, ctx);
+            return pending;
+        }
+
+        /**
+         * @brief Checks whether the resource is loaded, picking up the result of LoadAsync once it is ready.
+         */
+        bool IsReady()
+        {
+            if (data == nullptr && pending.valid() && pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                Attach(pending.get(), pendingRid);
+                pending = std::shared_future<T *>();
+            }
+            return data != nullptr;
+        }
+
+        /**
+         * @brief Checks whether a LoadAsync wasn't picked up by IsReady yet. A failed load stops loading without becoming ready.
+         */
+        bool IsLoading() const
+        {
+            return pending.valid();
+        }
+
         /**
          * @brief Copies the resource to the specified resource ID.
          *
@@ -95,12 +165,15 @@ namespace DT
         }
 
         /**
-         * @brief Unloads the resource.
+         * @brief Drops the handle's reference, the resource is unloaded once no handle references it and the memory budget needs the space.
          */
         void Unload()
         {
+            if (data != nullptr && referenced)
+                ResourceCache::Release<T>(referencedRid);
             data = nullptr;
-            T::UnloadResource(rid);
+            referenced = false;
+            pending = std::shared_future<T *>();
         }
 
         /**
@@ -117,5 +190,20 @@ namespace DT
          * @brief Serializes the resource.
          */
         IN_SERIALIZE(Resource, rid);
+
+    private:
+        std::shared_future<T *> pending; /// @brief Load started by LoadAsync.
+        RID pendingRid = 0;              /// @brief Resource ID pending was started for.
+        bool referenced = false;         /// @brief Whether data holds a ResourceCache reference.
+        RID referencedRid = 0;           /// @brief Entry the reference was acquired on, rid is public and may have changed since.
+
+        void Attach(T *loaded, RID loadedRid)
+        {
+            data = loaded;
+            referenced = data != nullptr;
+            referencedRid = loadedRid;
+            if (referenced)
+                ResourceCache::Acquire<T>(referencedRid);
+        }
     };
 }
\ No newline at end of file
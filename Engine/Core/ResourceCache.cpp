@@ -0,0 +1,198 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <iostream>
+
+#include <Core/ResourceCache.h>
+
+namespace DT
+{
+    void ResourceCache::Trim()
+    {
+        while (true)
+        {
+            Key key{typeid(void), 0};
+            {
+                std::lock_guard<std::mutex> lock(lruMutex);
+                if (lru.empty() || (cpuUsage <= cpuBudget && gpuUsage <= gpuBudget))
+                    return;
+                key = lru.front();
+            }
+
+            Erase(key, false);
+        }
+    }
+
+    std::vector<ResourceCache::EntryInfo> ResourceCache::GetEntries()
+    {
+        std::vector<EntryInfo> infos;
+        for (Shard &shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto &[key, entry] : shard.entries)
+                infos.push_back({entry.typeName, key.rid, entry.refs, entry.cpu, entry.gpu, entry.loadTime, entry.evictable});
+        }
+        return infos;
+    }
+
+    size_t ResourceCache::GetCPUUsage()
+    {
+        std::lock_guard<std::mutex> lock(lruMutex);
+        return cpuUsage;
+    }
+
+    size_t ResourceCache::GetGPUUsage()
+    {
+        std::lock_guard<std::mutex> lock(lruMutex);
+        return gpuUsage;
+    }
+
+    size_t ResourceCache::GetEntryCount()
+    {
+        size_t count = 0;
+        for (Shard &shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            count += shard.entries.size();
+        }
+        return count;
+    }
+
+    size_t ResourceCache::GetEvictableCount()
+    {
+        std::lock_guard<std::mutex> lock(lruMutex);
+        return lru.size();
+    }
+
+    unsigned int ResourceCache::GetEvictionCount()
+    {
+        std::lock_guard<std::mutex> lock(lruMutex);
+        return evictionCount;
+    }
+
+    void *ResourceCache::Insert(const Key &key, Entry entry)
+    {
+        Shard &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto [it, inserted] = shard.entries.try_emplace(key, std::move(entry));
+        if (inserted)
+        {
+            std::lock_guard<std::mutex> lruLock(lruMutex);
+            Measure(it->second);
+        }
+        return it->second.data;
+    }
+
+    void ResourceCache::Erase(const Key &key, bool force)
+    {
+        Entry entry;
+        {
+            Shard &shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            auto it = shard.entries.find(key);
+            // A handle may have picked the entry up again since Trim chose it
+            if (it == shard.entries.end() || (!force && !it->second.evictable))
+                return;
+
+            entry = it->second;
+            if (entry.refs > 0)
+                std::cout << "[ERR] [RESOURCE_UNLOADED_WHILE_REFERENCED] [" << key.rid << "] " << entry.refs << " handles left dangling\n";
+
+            {
+                std::lock_guard<std::mutex> lruLock(lruMutex);
+                if (entry.evictable)
+                    lru.erase(entry.lruPosition);
+                cpuUsage -= entry.cpu;
+                gpuUsage -= entry.gpu;
+                if (!force)
+                    evictionCount++;
+            }
+            shard.entries.erase(it);
+        }
+
+        // Destroying frees GL objects and may release nested resources, so no lock is held
+        entry.destroy(entry.data);
+    }
+
+    void ResourceCache::Acquire(const Key &key)
+    {
+        Shard &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end())
+            return;
+
+        Entry &entry = it->second;
+        if (entry.refs++ == 0 && entry.evictable)
+        {
+            std::lock_guard<std::mutex> lruLock(lruMutex);
+            lru.erase(entry.lruPosition);
+            entry.evictable = false;
+        }
+    }
+
+    void ResourceCache::Release(const Key &key)
+    {
+        Shard &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end() || it->second.refs == 0)
+            return;
+
+        Entry &entry = it->second;
+        if (--entry.refs > 0)
+            return;
+
+        std::lock_guard<std::mutex> lruLock(lruMutex);
+        // Sizes change after loading (GPU uploads, freed staging data), measure what eviction would actually free
+        Measure(entry);
+        entry.lruPosition = lru.insert(lru.end(), key);
+        entry.evictable = true;
+    }
+
+    void ResourceCache::Update(const Key &key, float loadTime)
+    {
+        Shard &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end())
+            return;
+
+        std::lock_guard<std::mutex> lruLock(lruMutex);
+        Measure(it->second);
+        it->second.loadTime = loadTime;
+    }
+
+    void ResourceCache::Measure(Entry &entry)
+    {
+        cpuUsage -= entry.cpu;
+        gpuUsage -= entry.gpu;
+        entry.measure(entry.data, entry.cpu, entry.gpu);
+        cpuUsage += entry.cpu;
+        gpuUsage += entry.gpu;
+    }
+}
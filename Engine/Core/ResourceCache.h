@@ -0,0 +1,416 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Core/ResourceManager.h>
+#include <Core/ContextPtr.h>
+
+namespace DT
+{
+    /**
+     * @brief Detects resource types reporting their own memory use through GetCPUMemory and GetGPUMemory.
+     */
+    template <typename T, typename = void>
+    struct HasMemoryUsage : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasMemoryUsage<T, std::void_t<decltype(std::declval<const T &>().GetCPUMemory()),
+                                         decltype(std::declval<const T &>().GetGPUMemory())>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Detects resource types owning GL objects that have to be freed with Delete before destruction.
+     */
+    template <typename T, typename = void>
+    struct HasDelete : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasDelete<T, std::void_t<decltype(std::declval<T &>().Delete())>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Detects resource types replacing a loaded copy with a reloaded one themselves through ReplaceResource.
+     */
+    template <typename T, typename = void>
+    struct HasReplaceResource : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasReplaceResource<T, std::void_t<decltype(T::ReplaceResource(std::declval<T *>(), std::declval<T *>(), std::declval<ContextPtr &>()))>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Visitor accepting any resource handle, used to detect ForEachDependency.
+     */
+    struct DependencyProbe
+    {
+        template <typename Handle>
+        void operator()(Handle &) const
+        {
+        }
+    };
+
+    /**
+     * @brief Detects resource types holding handles to other resources, visited by ForEachDependency.
+     */
+    template <typename T, typename = void>
+    struct HasDependencies : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasDependencies<T, std::void_t<decltype(std::declval<T &>().ForEachDependency(DependencyProbe{}))>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief How the ResourceCache creates and destroys a resource type. The default reads the resource with
+     * T::ReadResource and uploads it with T::UploadResource, types loaded differently specialize it.
+     *
+     * @tparam T The resource type.
+     */
+    template <typename T>
+    struct ResourceTraits
+    {
+        static constexpr const char *typeName = T::typeName; /// @brief Name shown by the editor.
+
+        static T *Load(RID rid, ContextPtr &ctx)
+        {
+            T *data = T::ReadResource(ctx.resourceManager->GetPath(rid));
+            if (data != nullptr)
+                T::UploadResource(data, ctx);
+            return data;
+        }
+
+        static void Destroy(T *data)
+        {
+            if constexpr (HasDelete<T>::value)
+                data->Delete();
+            delete data;
+        }
+
+        /**
+         * @brief Replaces a loaded resource with a freshly read (not uploaded) copy of it, keeping its address so
+         * everything pointing at it sees the new data. The default uploads the copy, swaps it in and destroys the old data.
+         *
+         * @param data The loaded resource.
+         * @param reloaded The freshly read copy, owned by Replace.
+         */
+        static void Replace(T *data, T *reloaded, ContextPtr &ctx)
+        {
+            if constexpr (HasReplaceResource<T>::value)
+                T::ReplaceResource(data, reloaded, ctx);
+            else
+            {
+                T::UploadResource(reloaded, ctx);
+                std::swap(*data, *reloaded);
+                Destroy(reloaded);
+            }
+        }
+    };
+
+    /**
+     * @brief Central cache of every loaded resource keyed by type and RID, with size accounting and load timings.
+     *
+     * Lookups take a shared lock on one of a fixed number of shards so worker threads can read the cache while the
+     * main thread inserts. Resource handles reference count entries, an entry whose last handle is released becomes
+     * evictable and Trim unloads evictable entries least recently released first while over the memory budgets.
+     * Entries loaded without a handle (editor icons and the like) are never evicted.
+     */
+    class ResourceCache
+    {
+    public:
+        static inline size_t cpuBudget = size_t(512) << 20; /// @brief Bytes of CPU memory the cache may hold before evicting.
+        static inline size_t gpuBudget = size_t(1) << 30;   /// @brief Bytes of GPU memory the cache may hold before evicting.
+
+        /**
+         * @brief Snapshot of one cache entry for introspection.
+         */
+        struct EntryInfo
+        {
+            const char *typeName;
+            RID rid;
+            unsigned int refs;
+            size_t cpu;
+            size_t gpu;
+            float loadTime; /// @brief Milliseconds spent loading the resource.
+            bool evictable;
+        };
+
+        /**
+         * @brief Looks up a loaded resource, safe to call from any thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID.
+         * @return The resource, nullptr if it isn't loaded.
+         */
+        template <typename T>
+        static T *Find(RID rid)
+        {
+            Key key{typeid(T), rid};
+            Shard &shard = GetShard(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            return it == shard.entries.end() ? nullptr : static_cast<T *>(it->second.data);
+        }
+
+        /**
+         * @brief Adds a loaded resource to the cache, safe to call from any thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID.
+         * @param data The loaded resource, destroyed if another copy was inserted first.
+         * @param loadTime Milliseconds spent loading the resource.
+         * @return The cached resource, either data or the copy inserted first.
+         */
+        template <typename T>
+        static T *Insert(RID rid, T *data, float loadTime)
+        {
+            Entry entry;
+            entry.data = data;
+            entry.typeName = ResourceTraits<T>::typeName;
+            entry.loadTime = loadTime;
+            entry.destroy = [](void *data)
+            { ResourceTraits<T>::Destroy(static_cast<T *>(data)); };
+            entry.measure = [](const void *data, size_t &cpu, size_t &gpu)
+            {
+                const T *resource = static_cast<const T *>(data);
+                if constexpr (HasMemoryUsage<T>::value)
+                {
+                    cpu = resource->GetCPUMemory();
+                    gpu = resource->GetGPUMemory();
+                }
+                else
+                {
+                    cpu = sizeof(T);
+                    gpu = 0;
+                }
+            };
+
+            void *cached = Insert(Key{typeid(T), rid}, std::move(entry));
+            if (cached != data)
+                ResourceTraits<T>::Destroy(data);
+            return static_cast<T *>(cached);
+        }
+
+        /**
+         * @brief Returns a resource, loading it first if it isn't cached yet. Must be called from the main thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID.
+         * @return The resource, nullptr if it failed to load.
+         */
+        template <typename T>
+        static T *Load(RID rid, ContextPtr &ctx)
+        {
+            if (T *data = Find<T>(rid))
+                return data;
+
+            using Clock = std::chrono::steady_clock;
+            Clock::time_point start = Clock::now();
+            T *data = ResourceTraits<T>::Load(rid, ctx);
+            if (data == nullptr)
+                return nullptr;
+            LoadDependencies<T>(rid, data, ctx);
+
+            return Insert<T>(rid, data, std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+        }
+
+        /**
+         * @brief Records the resources a freshly loaded resource references in the dependency graph and loads them
+         * into its handles right away, the synchronous counterpart of the ResourceLoader resolving them. Cached entries
+         * are handed out as they are, so nothing is inserted with its handles unresolved. Must be called from the main thread.
+         */
+        template <typename T>
+        static void LoadDependencies(RID rid, T *data, ContextPtr &ctx)
+        {
+            if constexpr (HasDependencies<T>::value)
+            {
+                std::vector<ResourceManager::Dependency> dependencies;
+                data->ForEachDependency([&](auto &handle)
+                                        {
+                                            using Dependency = typename std::decay_t<decltype(handle)>::Type;
+                                            if (handle.rid == 0 || !ctx.resourceManager->HasRID(handle.rid))
+                                                return;
+                                            dependencies.push_back({handle.rid, ResourceTraits<Dependency>::typeName});
+                                            handle.Load(handle.rid, ctx); });
+                ctx.resourceManager->SetDependencies(rid, std::move(dependencies));
+            }
+        }
+
+        /**
+         * @brief Removes a resource from the cache and destroys it. Must be called from the main thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID.
+         */
+        template <typename T>
+        static void Unload(RID rid)
+        {
+            Erase(Key{typeid(T), rid}, true);
+        }
+
+        /**
+         * @brief Records the new size and load time of a resource replaced in place. Must be called from the main thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID.
+         * @param loadTime Milliseconds spent reloading the resource.
+         */
+        template <typename T>
+        static void Update(RID rid, float loadTime)
+        {
+            Update(Key{typeid(T), rid}, loadTime);
+        }
+
+        /**
+         * @brief Calls a function on every cached resource of a type, outside of the cache locks.
+         *
+         * @tparam T The resource type.
+         * @param function Called with the RID and the resource.
+         */
+        template <typename T, typename Function>
+        static void ForEach(Function function)
+        {
+            std::vector<std::pair<RID, T *>> found;
+            for (Shard &shard : shards)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (auto &[key, entry] : shard.entries)
+                    if (key.type == typeid(T))
+                        found.emplace_back(key.rid, static_cast<T *>(entry.data));
+            }
+
+            for (auto &[rid, data] : found)
+                function(rid, data);
+        }
+
+        /**
+         * @brief Adds a handle reference to a cached resource, referenced resources are never evicted.
+         */
+        template <typename T>
+        static void Acquire(RID rid)
+        {
+            Acquire(Key{typeid(T), rid});
+        }
+
+        /**
+         * @brief Drops a handle reference, the resource becomes evictable when no reference is left.
+         */
+        template <typename T>
+        static void Release(RID rid)
+        {
+            Release(Key{typeid(T), rid});
+        }
+
+        /**
+         * @brief Unloads evictable resources, least recently released first, until both budgets are met. Called once per frame by the Engine.
+         */
+        static void Trim();
+
+        /**
+         * @brief Snapshot of every cached resource.
+         */
+        static std::vector<EntryInfo> GetEntries();
+
+        static size_t GetCPUUsage();         /// @brief Bytes of CPU memory used by cached resources.
+        static size_t GetGPUUsage();         /// @brief Bytes of GPU memory used by cached resources.
+        static size_t GetEntryCount();       /// @brief Number of cached resources.
+        static size_t GetEvictableCount();   /// @brief Number of cached resources no handle references anymore.
+        static unsigned int GetEvictionCount(); /// @brief Number of resources evicted since startup.
+
+    private:
+        static constexpr size_t shardCount = 16;
+
+        struct Key
+        {
+            std::type_index type;
+            RID rid;
+
+            bool operator==(const Key &other) const { return type == other.type && rid == other.rid; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key &key) const { return key.type.hash_code() ^ (std::hash<RID>()(key.rid) * 0x9E3779B97F4A7C15ull); }
+        };
+
+        struct Entry
+        {
+            void *data = nullptr;
+            const char *typeName = nullptr;
+            void (*destroy)(void *) = nullptr;
+            void (*measure)(const void *, size_t &, size_t &) = nullptr;
+            unsigned int refs = 0;
+            size_t cpu = 0;
+            size_t gpu = 0;
+            float loadTime = 0.f;
+            bool evictable = false;
+            std::list<Key>::iterator lruPosition;
+        };
+
+        struct Shard
+        {
+            std::shared_mutex mutex;
+            std::unordered_map<Key, Entry, KeyHash> entries;
+        };
+
+        static inline std::array<Shard, shardCount> shards;
+
+        // Accounting shared by every shard, always locked after a shard's mutex
+        static inline std::mutex lruMutex;
+        static inline std::list<Key> lru; /// @brief Evictable resources, least recently released first.
+        static inline size_t cpuUsage = 0;
+        static inline size_t gpuUsage = 0;
+        static inline unsigned int evictionCount = 0;
+
+        static Shard &GetShard(const Key &key) { return shards[KeyHash()(key) % shardCount]; }
+
+        static void *Insert(const Key &key, Entry entry);
+        static void Erase(const Key &key, bool force);
+        static void Acquire(const Key &key);
+        static void Release(const Key &key);
+        static void Update(const Key &key, float loadTime);
+        static void Measure(Entry &entry);
+    };
+}
@@ -0,0 +1,126 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+
+#include <Core/ResourceLoader.h>
+#include <Renderer/Mesh.h>
+
+namespace DT
+{
+    ResourceLoader::ResourceLoader()
+    {
+        // Leave a core for the main thread
+        unsigned int workerCount = std::clamp(std::thread::hardware_concurrency(), 2u, 9u) - 1;
+        for (unsigned int i = 0; i < workerCount; i++)
+            workers.emplace_back(&ResourceLoader::WorkerLoop, this);
+
+        // Scenes reference their resources through components, nothing depends on a scene
+        Register<Texture>();
+        Register<Shader>();
+        Register<Material>();
+        Register<Mesh>();
+
+        std::cout << "[LOG] ResourceLoader started " << workerCount << " workers\n";
+    }
+
+    ResourceLoader::~ResourceLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    void ResourceLoader::ProcessUploads(ContextPtr &ctx)
+    {
+        Clock::time_point start = Clock::now();
+
+        while (true)
+        {
+            std::function<void(ContextPtr &)> upload;
+            {
+                std::lock_guard<std::mutex> lock(uploadMutex);
+                if (uploads.empty())
+                    break;
+                upload = std::move(uploads.front());
+                uploads.pop_front();
+            }
+
+            upload(ctx);
+
+            if (Milliseconds(Clock::now() - start) >= uploadBudget)
+                break;
+        }
+
+        // Hand out the resources whose dependencies were uploaded meanwhile
+        PollWaiting(ctx);
+    }
+
+    void ResourceLoader::PollWaiting(ContextPtr &ctx)
+    {
+        // Finishing a resource may queue more waiting ones, iterate over a copy
+        std::vector<std::function<bool(ContextPtr &)>> polled;
+        polled.swap(waiting);
+        for (std::function<bool(ContextPtr &)> &resolve : polled)
+            if (!resolve(ctx))
+                waiting.push_back(std::move(resolve));
+    }
+
+    void ResourceLoader::EnqueueJob(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobs.push_back(std::move(job));
+        }
+        jobAvailable.notify_one();
+    }
+
+    void ResourceLoader::EnqueueUpload(std::function<void(ContextPtr &)> upload)
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex);
+        uploads.push_back(std::move(upload));
+    }
+
+    void ResourceLoader::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobAvailable.wait(lock, [this]()
+                                  { return stopping || !jobs.empty(); });
+                if (stopping)
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            job();
+        }
+    }
+}
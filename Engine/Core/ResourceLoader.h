@@ -0,0 +1,345 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Core/ResourceManager.h>
+#include <Core/ResourceCache.h>
+#include <Core/ContextPtr.h>
+
+namespace DT
+{
+    /**
+     * @brief Detects resource types split into a thread safe ReadResource (file I/O and decoding) and a main thread
+     * UploadResource (GL calls). Other types are loaded whole through their ResourceTraits on the main thread.
+     */
+    template <typename T, typename = void>
+    struct HasAsyncLoad : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct HasAsyncLoad<T, std::void_t<decltype(T::ReadResource(std::declval<const std::filesystem::path &>())),
+                                       decltype(T::UploadResource(std::declval<T *>(), std::declval<ContextPtr &>()))>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Loads resources on a pool of worker threads and hands their GL uploads back to the main thread.
+     */
+    class ResourceLoader
+    {
+    public:
+        float uploadBudget = 2.f; /// @brief Milliseconds ProcessUploads may spend per frame, at least one upload always runs.
+
+        ResourceLoader();
+        ~ResourceLoader();
+
+        /**
+         * @brief Makes a resource type loadable as the dependency of another, by the type name recorded in the dependency graph.
+         *
+         * @tparam T The resource type.
+         */
+        template <typename T>
+        void Register()
+        {
+            prefetchers[ResourceTraits<T>::typeName] = [this](RID rid, ContextPtr &ctx)
+            { Request<T>(rid, ctx); };
+        }
+
+        /**
+         * @brief Starts loading a resource in the background, a resource already loaded or loading is not loaded twice.
+         * Everything the dependency graph says it depends on starts loading right away as well, so the workers read
+         * independent dependencies in parallel. Must be called from the main thread.
+         *
+         * @tparam T The resource type.
+         * @param rid The resource ID to load.
+         * @return Future resolved on the main thread once the resource and the resources it references are uploaded,
+         * holds nullptr if it failed to load.
+         */
+        template <typename T>
+        std::shared_future<T *> LoadAsync(RID rid, ContextPtr &ctx)
+        {
+            if (T *cached = ResourceCache::Find<T>(rid))
+                return Ready(cached);
+
+            // Dependencies come before their dependents, the workers pick the leaves up first
+            for (const ResourceManager::Dependency &dependency : ctx.resourceManager->GetClosure(rid))
+            {
+                // The graph is saved with the context and may name resources removed since
+                if (!ctx.resourceManager->HasRID(dependency.rid))
+                    continue;
+
+                auto prefetcher = prefetchers.find(dependency.type);
+                if (prefetcher != prefetchers.end())
+                    prefetcher->second(dependency.rid, ctx);
+            }
+
+            return Request<T>(rid, ctx);
+        }
+
+        /**
+         * @brief Rereads a cached resource in the background and replaces it in place on the main thread, so handles
+         * and dependents pointing at it see the new data. The old data stays in use if reading fails.
+         * Must be called from the main thread.
+         *
+         * @tparam T The resource type, must be split into ReadResource and UploadResource.
+         * @param rid The resource ID to reload.
+         * @param reloaded Called on the main thread once the resource was replaced.
+         */
+        template <typename T>
+        void Reload(RID rid, ContextPtr &ctx, std::function<void(ContextPtr &)> reloaded = nullptr)
+        {
+            static_assert(HasAsyncLoad<T>::value, "Only resources split into ReadResource and UploadResource can be reloaded in place");
+
+            std::filesystem::path path = ctx.resourceManager->GetPath(rid);
+            pendingLoads++;
+            EnqueueJob([this, rid, path, reloaded]()
+                       {
+                           Clock::time_point start = Clock::now();
+                           T *data = nullptr;
+                           try
+                           {
+                               data = T::ReadResource(path);
+                           }
+                           catch (std::exception &e)
+                           {
+                               std::cout << "[ERR] [RELOAD_FAIL] [" << path.string() << "] " << e.what() << std::endl;
+                           }
+                           float readTime = Milliseconds(Clock::now() - start);
+
+                           EnqueueUpload([this, rid, data, readTime, reloaded](ContextPtr &ctx)
+                                         {
+                                             if (data == nullptr)
+                                             {
+                                                 pendingLoads--;
+                                                 return;
+                                             }
+
+                                             // Attach the dependencies of the new copy first, dependents must never see its handles unresolved
+                                             ResolveDependencies<T>(rid, data, ctx, [this, rid, data, readTime, reloaded](ContextPtr &ctx)
+                                                                    {
+                                                                        pendingLoads--;
+                                                                        Clock::time_point start = Clock::now();
+                                                                        T *cached = ResourceCache::Find<T>(rid);
+                                                                        if (cached == nullptr)
+                                                                        {
+                                                                            // Evicted meanwhile, nothing points at it anymore
+                                                                            ResourceTraits<T>::Destroy(data);
+                                                                            return;
+                                                                        }
+
+                                                                        ResourceTraits<T>::Replace(cached, data, ctx);
+                                                                        ResourceCache::Update<T>(rid, readTime + Milliseconds(Clock::now() - start));
+                                                                        if (reloaded)
+                                                                            reloaded(ctx); }); }); });
+        }
+
+        /**
+         * @brief Runs queued GL uploads on the calling (main) thread until uploadBudget is spent. Called once per frame by the Engine.
+         */
+        void ProcessUploads(ContextPtr &ctx);
+
+        /**
+         * @brief Number of loads requested and not uploaded yet.
+         */
+        unsigned int GetPendingLoads() const { return pendingLoads; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> jobs;
+        std::deque<std::function<void(ContextPtr &)>> uploads;
+        std::mutex jobMutex;
+        std::mutex uploadMutex;
+        std::condition_variable jobAvailable;
+        bool stopping = false;
+        unsigned int pendingLoads = 0; /// @brief Only touched on the main thread.
+
+        template <typename T>
+        static std::unordered_map<RID, std::shared_future<T *>> &Loading()
+        {
+            static std::unordered_map<RID, std::shared_future<T *>> loading;
+            return loading;
+        }
+
+        std::unordered_map<std::string, std::function<void(RID, ContextPtr &)>> prefetchers; /// @brief Request of each registered type by type name.
+        std::vector<std::function<bool(ContextPtr &)>> waiting;                             /// @brief Loaded resources waiting for their dependencies, only touched on the main thread.
+
+        template <typename T>
+        static std::shared_future<T *> Ready(T *data)
+        {
+            std::promise<T *> loaded;
+            loaded.set_value(data);
+            return loaded.get_future().share();
+        }
+
+        /**
+         * @brief Starts loading a single resource, without looking at its dependency graph.
+         */
+        template <typename T>
+        std::shared_future<T *> Request(RID rid, ContextPtr &ctx)
+        {
+            if (T *cached = ResourceCache::Find<T>(rid))
+                return Ready(cached);
+
+            std::unordered_map<RID, std::shared_future<T *>> &loading = Loading<T>();
+            auto it = loading.find(rid);
+            if (it != loading.end())
+                return it->second;
+
+            std::shared_ptr<std::promise<T *>> promise = std::make_shared<std::promise<T *>>();
+            std::shared_future<T *> future = promise->get_future().share();
+            loading[rid] = future;
+            pendingLoads++;
+
+            auto finish = [this, rid, promise](T *data, float loadTime)
+            {
+                // The loading list is only ever touched on the main thread
+                if (data != nullptr)
+                    data = ResourceCache::Insert<T>(rid, data, loadTime); // Keeps the copy loaded synchronously meanwhile, if any
+                Loading<T>().erase(rid);
+                pendingLoads--;
+                promise->set_value(data);
+            };
+
+            if constexpr (HasAsyncLoad<T>::value)
+            {
+                std::filesystem::path path = ctx.resourceManager->GetPath(rid);
+                EnqueueJob([this, rid, path, finish]()
+                           {
+                               Clock::time_point start = Clock::now();
+                               T *data = nullptr;
+                               try
+                               {
+                                   data = T::ReadResource(path);
+                               }
+                               catch (std::exception &e)
+                               {
+                                   std::cout << "[ERR] [ASYNC_LOAD_FAIL] [" << path.string() << "] " << e.what() << std::endl;
+                               }
+                               float readTime = Milliseconds(Clock::now() - start);
+
+                               EnqueueUpload([this, rid, data, readTime, finish](ContextPtr &ctx)
+                                             {
+                                                 if (data == nullptr)
+                                                 {
+                                                     finish(nullptr, readTime);
+                                                     return;
+                                                 }
+
+                                                 Clock::time_point start = Clock::now();
+                                                 T::UploadResource(data, ctx);
+                                                 float loadTime = readTime + Milliseconds(Clock::now() - start);
+                                                 ResolveDependencies<T>(rid, data, ctx, [data, loadTime, finish](ContextPtr &)
+                                                                        { finish(data, loadTime); }); });
+                           });
+            }
+            else
+            {
+                EnqueueUpload([rid, finish](ContextPtr &ctx)
+                              {
+                                  Clock::time_point start = Clock::now();
+                                  T *data = nullptr;
+                                  try
+                                  {
+                                      data = ResourceTraits<T>::Load(rid, ctx);
+                                      if (data != nullptr)
+                                          ResourceCache::LoadDependencies<T>(rid, data, ctx);
+                                  }
+                                  catch (std::exception &e)
+                                  {
+                                      std::cout << "[ERR] [ASYNC_LOAD_FAIL] [" << rid << "] " << e.what() << std::endl;
+                                  }
+                                  finish(data, Milliseconds(Clock::now() - start)); });
+            }
+
+            return future;
+        }
+
+        /**
+         * @brief Records the resources a freshly read resource references in the dependency graph, starts loading
+         * them into its handles and calls done once they are all settled, so the resource is never handed out half loaded.
+         */
+        template <typename T>
+        void ResolveDependencies(RID rid, T *data, ContextPtr &ctx, std::function<void(ContextPtr &)> done)
+        {
+            if constexpr (HasDependencies<T>::value)
+            {
+                std::vector<ResourceManager::Dependency> dependencies;
+                data->ForEachDependency([&](auto &handle)
+                                        {
+                                            using Dependency = typename std::decay_t<decltype(handle)>::Type;
+                                            if (handle.rid == 0 || !ctx.resourceManager->HasRID(handle.rid))
+                                                return;
+                                            dependencies.push_back({handle.rid, ResourceTraits<Dependency>::typeName});
+                                            handle.LoadAsync(handle.rid, ctx); });
+                bool dependent = !dependencies.empty();
+                ctx.resourceManager->SetDependencies(rid, std::move(dependencies));
+
+                if (dependent)
+                {
+                    waiting.push_back([data, done](ContextPtr &ctx)
+                                      {
+                                          bool loading = false;
+                                          data->ForEachDependency([&loading](auto &handle)
+                                                                  {
+                                                                      handle.IsReady();
+                                                                      loading |= handle.IsLoading(); });
+                                          if (loading)
+                                              return false;
+                                          done(ctx);
+                                          return true; });
+                    return;
+                }
+            }
+
+            done(ctx);
+        }
+
+        void PollWaiting(ContextPtr &ctx);
+
+        static float Milliseconds(Clock::duration duration) { return std::chrono::duration<float, std::milli>(duration).count(); }
+
+        void EnqueueJob(std::function<void()> job);
+        void EnqueueUpload(std::function<void(ContextPtr &)> upload);
+        void WorkerLoop();
+    };
+}
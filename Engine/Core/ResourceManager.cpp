@@ -20,10 +20,13 @@ the following email address:
 aryanbaburajan2007@gmail.com
 */
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <unordered_set>
 
 #include <Core/ResourceManager.h>
+#include <Core/PackFile.h>
 
 namespace DT
 {
@@ -34,28 +37,227 @@ namespace DT
 
     std::filesystem::path ResourceManager::GetPath(RID rid)
     {
-
-        return resourceMap[rid];
+        auto it = resourceMap.find(rid);
+        if (it == resourceMap.end())
+            return std::filesystem::path();
+        return it->second;
     }
 
     RID ResourceManager::GetRID(const std::filesystem::path &path)
     {
-        for (auto &resource : resourceMap)
-            if (resource.second == path)
-                return resource.first;
+        EnsureIndexed();
+
+        std::string key = NormalizePath(path);
+        auto it = pathMap.find(key);
+        if (it != pathMap.end())
+            return it->second;
 
-        RID rid = 1;
-        while (HasRID(rid))
-            rid++;
+        RID rid;
+        if (!freeRIDs.empty())
+        {
+            rid = freeRIDs.back();
+            freeRIDs.pop_back();
+        }
+        else
+            rid = nextRID++;
 
         resourceMap[rid] = path;
+        pathMap.emplace(std::move(key), rid);
+        indexedResources = resourceMap.size();
+        generation++;
         return rid;
     }
 
+    RID ResourceManager::FindRID(const std::filesystem::path &path)
+    {
+        EnsureIndexed();
+
+        auto it = pathMap.find(NormalizePath(path));
+        return it == pathMap.end() ? 0 : it->second;
+    }
+
+    void ResourceManager::ReleaseRID(RID rid)
+    {
+        EnsureIndexed();
+
+        auto it = resourceMap.find(rid);
+        if (it == resourceMap.end())
+            return;
+
+        pathMap.erase(NormalizePath(it->second));
+        resourceMap.erase(it);
+        dependencies.erase(rid);
+        freeRIDs.push_back(rid);
+        indexedResources = resourceMap.size();
+        generation++;
+    }
+
     bool ResourceManager::HasRID(RID rid)
     {
         if (resourceMap.count(rid))
             return true;
         return false;
     }
-}
\ No newline at end of file
+
+    void ResourceManager::SetDependencies(RID rid, std::vector<Dependency> resourceDependencies)
+    {
+        if (resourceDependencies.empty())
+            dependencies.erase(rid);
+        else
+            dependencies[rid] = std::move(resourceDependencies);
+    }
+
+    json ResourceManager::SaveManifest() const
+    {
+        json manifest = json::object();
+        for (const auto &[rid, resourceDependencies] : dependencies)
+        {
+            auto resource = resourceMap.find(rid);
+            if (resource == resourceMap.end())
+                continue;
+
+            json &edges = manifest[resource->second.string()];
+            edges = json::array();
+            for (const Dependency &dependency : resourceDependencies)
+            {
+                auto path = resourceMap.find(dependency.rid);
+                if (path != resourceMap.end())
+                    edges.push_back({{"path", path->second.string()}, {"type", dependency.type}});
+            }
+        }
+        return manifest;
+    }
+
+    void ResourceManager::LoadManifest(const json &manifest)
+    {
+        // Packs register the paths they hold when mounted, anything else has to exist on disk
+        auto resolve = [this](const std::filesystem::path &path) -> RID
+        {
+            RID rid = FindRID(path);
+            if (rid == 0 && std::filesystem::exists(path))
+                rid = GetRID(path);
+            return rid;
+        };
+
+        for (auto &[path, edges] : manifest.items())
+        {
+            RID rid = resolve(path);
+            if (rid == 0)
+                continue;
+
+            std::vector<Dependency> resourceDependencies;
+            for (const json &edge : edges)
+                if (RID dependency = resolve(edge.at("path").get<std::string>()))
+                    resourceDependencies.push_back({dependency, edge.at("type").get<std::string>()});
+            SetDependencies(rid, std::move(resourceDependencies));
+        }
+    }
+
+    std::vector<ResourceManager::Dependency> ResourceManager::GetClosure(RID rid)
+    {
+        std::vector<Dependency> closure;
+        std::unordered_set<RID> visited{rid};
+
+        // Iterative depth first walk emitting each resource once all of its dependencies were emitted
+        struct Frame
+        {
+            Dependency dependency;
+            size_t next;
+        };
+        std::vector<Frame> stack{{Dependency{rid, ""}, 0}};
+        while (!stack.empty())
+        {
+            Frame &frame = stack.back();
+            auto edges = dependencies.find(frame.dependency.rid);
+            if (edges != dependencies.end() && frame.next < edges->second.size())
+            {
+                const Dependency &dependency = edges->second[frame.next++];
+                if (visited.insert(dependency.rid).second)
+                    stack.push_back({dependency, 0});
+                continue;
+            }
+
+            if (stack.size() > 1)
+                closure.push_back(std::move(frame.dependency));
+            stack.pop_back();
+        }
+
+        return closure;
+    }
+
+    bool ResourceManager::Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint)
+    {
+        std::shared_ptr<PackArchive> archive = VirtualFileSystem::Mount(packPath, mountPoint);
+        if (!archive)
+            return false;
+
+        EnsureIndexed();
+
+        unsigned int conflicts = 0;
+        for (uint32_t i = 0; i < archive->GetEntryCount(); i++)
+        {
+            const PackFile::Entry &entry = archive->GetEntry(i);
+            std::filesystem::path path = mountPoint / archive->GetPath(entry);
+            std::string key = NormalizePath(path);
+
+            auto known = pathMap.find(key);
+            if (known != pathMap.end() || resourceMap.count(entry.rid))
+            {
+                // Scenes saved against the pack's project refer to its RIDs, a different mapping breaks them
+                if (known == pathMap.end() || known->second != entry.rid)
+                    conflicts++;
+                continue;
+            }
+
+            resourceMap[entry.rid] = path;
+            pathMap.emplace(std::move(key), entry.rid);
+        }
+
+        // Packed RIDs may sit anywhere, rebuild the allocator around them
+        Reindex();
+
+        if (conflicts > 0)
+            std::cout << "[ERR] [PACK_RID_CONFLICT] [" << packPath.string() << "] " << conflicts << " resources are registered under other RIDs\n";
+        return true;
+    }
+
+    void ResourceManager::Reindex()
+    {
+        pathMap.clear();
+        pathMap.reserve(resourceMap.size());
+        freeRIDs.clear();
+        nextRID = 1;
+
+        for (auto &[rid, path] : resourceMap)
+        {
+            pathMap.emplace(NormalizePath(path), rid);
+            nextRID = std::max(nextRID, rid + 1);
+        }
+
+        // Gaps left by deserialized projects are handed out first, lowest last so it's reused first
+        for (RID rid = nextRID - 1; rid >= 1; rid--)
+            if (!resourceMap.count(rid))
+                freeRIDs.push_back(rid);
+
+        indexedResources = resourceMap.size();
+        generation++;
+    }
+
+    unsigned int ResourceManager::GetGeneration()
+    {
+        EnsureIndexed();
+        return generation;
+    }
+
+    std::string ResourceManager::NormalizePath(const std::filesystem::path &path)
+    {
+        return path.lexically_normal().generic_string();
+    }
+
+    void ResourceManager::EnsureIndexed()
+    {
+        // resourceMap is public and serialized wholesale, a size mismatch means it was replaced behind our back
+        if (indexedResources != resourceMap.size())
+            Reindex();
+    }
+}
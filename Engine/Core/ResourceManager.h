@@ -23,6 +23,9 @@ aryanbaburajan2007@gmail.com
 #pragma once
 
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <Core/Serialization.h>
 
@@ -39,6 +42,17 @@ namespace DT
     class ResourceManager
     {
     public:
+        /**
+         * @brief Edge of the resource dependency graph.
+         */
+        struct Dependency
+        {
+            RID rid;
+            std::string type; /// @brief ResourceTraits typeName of the resource depended on.
+
+            IN_SERIALIZE(Dependency, rid, type);
+        };
+
         ResourceManager();
 
         /**
@@ -46,6 +60,12 @@ namespace DT
          */
         std::unordered_map<RID, std::filesystem::path> resourceMap;
 
+        /**
+         * @brief Resources each resource references directly. Recorded whenever a resource is read and stored with the
+         * project through the manifest, so later loads know a resource's whole closure before reading any of it.
+         */
+        std::unordered_map<RID, std::vector<Dependency>> dependencies;
+
         /**
          * @brief Retrieves the file path associated with a resource ID.
          *
@@ -55,13 +75,28 @@ namespace DT
         std::filesystem::path GetPath(RID rid);
 
         /**
-         * @brief Retrieves the resource ID associated with a file path.
+         * @brief Retrieves the resource ID associated with a file path, registering the path if it is unknown.
          *
-         * @param path The file path.
+         * @param path The file path, spellings that normalize to the same path share their ID.
          * @return The resource ID associated with the file path.
          */
         RID GetRID(const std::filesystem::path &path);
 
+        /**
+         * @brief Looks up the resource ID of a file path without registering it.
+         *
+         * @param path The file path.
+         * @return The resource ID, 0 if the path is unknown.
+         */
+        RID FindRID(const std::filesystem::path &path);
+
+        /**
+         * @brief Forgets a resource ID, it is handed out again to the next new path.
+         *
+         * @param rid The resource ID to release.
+         */
+        void ReleaseRID(RID rid);
+
         /**
          * @brief Checks if a resource ID exists.
          *
@@ -70,9 +105,80 @@ namespace DT
          */
         bool HasRID(RID rid);
 
+        /**
+         * @brief Records the resources a resource references directly, replacing what was recorded before.
+         *
+         * @param rid The resource ID.
+         * @param resourceDependencies The resources it references.
+         */
+        void SetDependencies(RID rid, std::vector<Dependency> resourceDependencies);
+
+        /**
+         * @brief Collects every resource a resource depends on directly or indirectly, as far as the graph is known.
+         *
+         * @param rid The resource ID.
+         * @return The dependencies, each listed once and after everything it depends on itself.
+         */
+        std::vector<Dependency> GetClosure(RID rid);
+
+        /**
+         * @brief Writes the dependency graph keyed by path instead of RID, RIDs are handed out anew every session.
+         *
+         * @return JSON object mapping each resource path to the paths and types of the resources it references.
+         */
+        json SaveManifest() const;
+
+        /**
+         * @brief Adds a dependency graph written by SaveManifest, registering the paths it names. Resources whose file
+         * is gone and isn't held by a mounted pack are skipped.
+         *
+         * @param manifest The object returned by SaveManifest.
+         */
+        void LoadManifest(const json &manifest);
+
+        /**
+         * @brief Mounts a pack in place of the files under mountPoint and registers the resources it holds under the
+         * RIDs they were packed with, unless the RID or the path is already taken.
+         *
+         * @param packPath The pack to mount.
+         * @param mountPoint Directory the paths stored in the pack are relative to.
+         * @return Whether the pack was mounted.
+         */
+        bool Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint);
+
+        /**
+         * @brief Rebuilds the path index and the ID allocator from resourceMap. Called automatically when resourceMap was
+         * replaced, for example by deserialization, must be called after editing resourceMap in place.
+         */
+        void Reindex();
+
+        /**
+         * @brief Counter bumped by every change made to resourceMap through the manager, so that others can tell when
+         * it changed without comparing it.
+         */
+        unsigned int GetGeneration();
+
         /**
          * @brief Serializes the resource manager.
          */
-        IN_SERIALIZE(ResourceManager, resourceMap);
+        friend void to_json(nlohmann::json &nlohmann_json_j, const ResourceManager &nlohmann_json_t)
+        {
+            nlohmann_json_j["resourceMap"] = nlohmann_json_t.resourceMap;
+        }
+        friend void from_json(const nlohmann::json &nlohmann_json_j, ResourceManager &nlohmann_json_t)
+        {
+            nlohmann_json_j.at("resourceMap").get_to(nlohmann_json_t.resourceMap);
+            nlohmann_json_t.Reindex();
+        }
+
+    private:
+        std::unordered_map<std::string, RID> pathMap; /// @brief Reverse index of resourceMap keyed on the normalized path.
+        std::vector<RID> freeRIDs;                    /// @brief Released IDs, reused before new ones are allocated.
+        RID nextRID = 1;                              /// @brief Smallest ID that was never handed out.
+        size_t indexedResources = 0;                  /// @brief Size of resourceMap as of the last change made through the index.
+        unsigned int generation = 1;                  /// @brief See GetGeneration, starts at 1 so 0 can stand for never synced.
+
+        static std::string NormalizePath(const std::filesystem::path &path);
+        void EnsureIndexed();
     };
 }
\ No newline at end of file
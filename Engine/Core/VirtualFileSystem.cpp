@@ -0,0 +1,115 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <iostream>
+#include <mutex>
+
+#include <Core/VirtualFileSystem.h>
+#include <Core/PackFile.h>
+#include <Core/Platform.h>
+
+namespace DT
+{
+    std::shared_ptr<PackArchive> VirtualFileSystem::Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint)
+    {
+        std::shared_ptr<PackArchive> archive = std::make_shared<PackArchive>();
+        if (!archive->Open(packPath))
+            return nullptr;
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        mounts.push_back({archive, packPath, std::filesystem::absolute(mountPoint).lexically_normal()});
+
+        std::cout << "[LOG] Mounted " << packPath.string() << " (" << archive->GetEntryCount() << " files) at " << mountPoint.string() << "\n";
+        return archive;
+    }
+
+    void VirtualFileSystem::Unmount(const std::filesystem::path &packPath)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (auto it = mounts.begin(); it != mounts.end(); it++)
+            if (it->packPath == packPath)
+            {
+                mounts.erase(it);
+                return;
+            }
+    }
+
+    FileView VirtualFileSystem::Open(const std::filesystem::path &path)
+    {
+        std::shared_ptr<PackArchive> archive;
+        if (const PackFile::Entry *entry = FindPacked(path, archive))
+            return archive->Read(*entry);
+
+        std::shared_ptr<Platform::MappedFile> file = std::make_shared<Platform::MappedFile>();
+        if (!file->Open(path))
+            return FileView();
+
+        FileView view;
+        view.data = file->data;
+        view.size = file->size;
+        view.owner = file;
+        return view;
+    }
+
+    std::shared_ptr<PackStream> VirtualFileSystem::OpenStream(const std::filesystem::path &path)
+    {
+        std::shared_ptr<PackArchive> archive;
+        const PackFile::Entry *entry = FindPacked(path, archive);
+        if (entry == nullptr)
+            return nullptr;
+
+        PackFile::Compression compression = static_cast<PackFile::Compression>(entry->compression);
+        if (compression != PackFile::Compression::LZ4 && compression != PackFile::Compression::LZ4High)
+            return nullptr;
+
+        return std::make_shared<PackStream>(archive->OpenStream(*entry));
+    }
+
+    bool VirtualFileSystem::Exists(const std::filesystem::path &path)
+    {
+        std::shared_ptr<PackArchive> archive;
+        std::error_code error;
+        return FindPacked(path, archive) != nullptr || std::filesystem::is_regular_file(path, error);
+    }
+
+    const PackFile::Entry *VirtualFileSystem::FindPacked(const std::filesystem::path &path, std::shared_ptr<PackArchive> &archive)
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (mounts.empty())
+            return nullptr;
+
+        std::filesystem::path absolutePath = std::filesystem::absolute(path).lexically_normal();
+        for (auto it = mounts.rbegin(); it != mounts.rend(); it++)
+        {
+            std::filesystem::path relative = absolutePath.lexically_relative(it->mountPoint);
+            if (relative.empty() || *relative.begin() == "..")
+                continue;
+
+            if (const PackFile::Entry *entry = it->archive->Find(relative))
+            {
+                archive = it->archive;
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+}
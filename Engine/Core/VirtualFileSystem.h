@@ -0,0 +1,130 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace DT
+{
+    class PackArchive;
+    class PackStream;
+
+    namespace PackFile
+    {
+        struct Entry;
+    }
+
+    /**
+     * @brief Read-only contents of a file opened through the VirtualFileSystem. Shares ownership of the mapping or
+     * buffer backing the bytes, so views can be kept around after the file was unmounted.
+     */
+    struct FileView
+    {
+        const unsigned char *data = nullptr; /// @brief Start of the file contents, nullptr for empty files.
+        size_t size = 0;                     /// @brief Size of the file contents in bytes.
+        std::shared_ptr<const void> owner;   /// @brief Keeps data alive, nullptr if the file couldn't be opened.
+
+        /**
+         * @brief Whether the file was opened, empty files are open but have no data.
+         */
+        bool IsOpen() const { return owner != nullptr; }
+
+        /**
+         * @brief The contents as text, for parsers taking strings.
+         */
+        std::string_view AsString() const { return std::string_view(reinterpret_cast<const char *>(data), size); }
+    };
+
+    /**
+     * @brief File layer resources are read through. Paths under a mounted pack's mount point are served from the
+     * pack, everything else is memory mapped from the disk. Safe to use from any thread.
+     */
+    class VirtualFileSystem
+    {
+    public:
+        /**
+         * @brief Serves the files of a pack in place of the files under mountPoint. Packs mounted last take precedence.
+         *
+         * @param packPath The pack to mount.
+         * @param mountPoint Directory the paths stored in the pack are relative to.
+         * @return The mounted pack, nullptr if it isn't a valid pack.
+         */
+        static std::shared_ptr<PackArchive> Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint);
+
+        /**
+         * @brief Stops serving files from a pack, views already opened from it stay valid.
+         *
+         * @param packPath The pack passed to Mount.
+         */
+        static void Unmount(const std::filesystem::path &packPath);
+
+        /**
+         * @brief Opens a file, from the packs if one of them holds it and from the disk otherwise.
+         *
+         * @param path The file path.
+         * @return The file contents, not open if the file doesn't exist.
+         */
+        static FileView Open(const std::filesystem::path &path);
+
+        /**
+         * @brief Opens a compressed file of a mounted pack as a stream, for loaders decompressing it straight into
+         * their destination instead of a buffer of its own.
+         *
+         * @param path The file path.
+         * @return The stream, nullptr if no pack holds the file or it is stored uncompressed, Open serves those in place.
+         */
+        static std::shared_ptr<PackStream> OpenStream(const std::filesystem::path &path);
+
+        /**
+         * @brief Checks whether a file exists in a mounted pack or on the disk.
+         *
+         * @param path The file path.
+         */
+        static bool Exists(const std::filesystem::path &path);
+
+    private:
+        struct MountedPack
+        {
+            std::shared_ptr<PackArchive> archive;
+            std::filesystem::path packPath;
+            std::filesystem::path mountPoint; /// @brief Absolute and normalized.
+        };
+
+        static inline std::shared_mutex mutex;
+        static inline std::vector<MountedPack> mounts;
+
+        /**
+         * @brief Looks a file up in the mounted packs.
+         *
+         * @param path The file path.
+         * @param archive Set to the pack holding the file.
+         * @return The pack entry of the file, nullptr if no pack holds it.
+         */
+        static const PackFile::Entry *FindPacked(const std::filesystem::path &path, std::shared_ptr<PackArchive> &archive);
+    };
+}
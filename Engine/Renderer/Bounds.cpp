@@ -0,0 +1,95 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+
+#include <Renderer/Bounds.h>
+
+namespace DT
+{
+    AABB AABB::Transform(const glm::mat4 &transform) const
+    {
+        // Transform the center, and project the extents on each axis of the transformed basis
+        glm::vec3 center = glm::vec3(transform * glm::vec4(Center(), 1.f));
+        glm::mat3 basis = glm::mat3(transform);
+        glm::vec3 extents = Extents();
+        glm::vec3 transformedExtents(0.f);
+
+        for (int column = 0; column < 3; column++)
+            transformedExtents += glm::abs(basis[column]) * extents[column];
+
+        return AABB{center - transformedExtents, center + transformedExtents};
+    }
+
+    BoundingSphere BoundingSphere::Transform(const glm::mat4 &transform) const
+    {
+        float scale = std::max({glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))});
+
+        return BoundingSphere{glm::vec3(transform * glm::vec4(center, 1.f)), radius * scale};
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4 &viewProjection)
+    {
+        // Gribb-Hartmann extraction, glm matrices are column major so rows are gathered by hand
+        glm::vec4 rows[4];
+        for (int i = 0; i < 4; i++)
+            rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+        Frustum frustum;
+        frustum.planes[0] = rows[3] + rows[0];
+        frustum.planes[1] = rows[3] - rows[0];
+        frustum.planes[2] = rows[3] + rows[1];
+        frustum.planes[3] = rows[3] - rows[1];
+        frustum.planes[4] = rows[3] + rows[2];
+        frustum.planes[5] = rows[3] - rows[2];
+
+        for (glm::vec4 &plane : frustum.planes)
+            plane /= glm::length(glm::vec3(plane));
+
+        return frustum;
+    }
+
+    bool Frustum::Intersects(const BoundingSphere &sphere) const
+    {
+        for (const glm::vec4 &plane : planes)
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+                return false;
+
+        return true;
+    }
+
+    bool Frustum::Intersects(const AABB &box) const
+    {
+        glm::vec3 center = box.Center();
+        glm::vec3 extents = box.Extents();
+
+        for (const glm::vec4 &plane : planes)
+        {
+            // Distance of the box's corner furthest along the plane normal
+            glm::vec3 normal = glm::vec3(plane);
+            if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extents) + plane.w < 0.f)
+                return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace DT
+{
+    /**
+     * @brief Axis aligned bounding box.
+     */
+    struct AABB
+    {
+        glm::vec3 min = glm::vec3(0.f); /// @brief Corner with the smallest coordinates.
+        glm::vec3 max = glm::vec3(0.f); /// @brief Corner with the largest coordinates.
+
+        /**
+         * @brief Center of the box.
+         */
+        glm::vec3 Center() const { return (min + max) * 0.5f; }
+
+        /**
+         * @brief Half of the box's size along each axis.
+         */
+        glm::vec3 Extents() const { return (max - min) * 0.5f; }
+
+        /**
+         * @brief Computes the box enclosing this box once transformed.
+         * @param transform Transformation to apply, usually a model matrix.
+         * @return The transformed box, still axis aligned.
+         */
+        AABB Transform(const glm::mat4 &transform) const;
+    };
+
+    /**
+     * @brief Bounding sphere.
+     */
+    struct BoundingSphere
+    {
+        glm::vec3 center = glm::vec3(0.f); /// @brief Center of the sphere.
+        float radius = 0.f;                /// @brief Radius of the sphere.
+
+        /**
+         * @brief Computes the sphere enclosing this sphere once transformed.
+         * @param transform Transformation to apply, usually a model matrix.
+         * @return The transformed sphere, scaled by the transform's largest axis scale.
+         */
+        BoundingSphere Transform(const glm::mat4 &transform) const;
+    };
+
+    /**
+     * @brief View frustum described by its six planes, normals pointing inside.
+     */
+    struct Frustum
+    {
+        glm::vec4 planes[6] = {glm::vec4(0.f), glm::vec4(0.f), glm::vec4(0.f), glm::vec4(0.f), glm::vec4(0.f), glm::vec4(0.f)}; /// @brief Left, right, bottom, top, near and far planes as (normal, distance). All zero planes accept everything.
+
+        /**
+         * @brief Extracts the frustum planes from a view projection matrix.
+         * @param viewProjection Projection matrix multiplied by the view matrix. World space planes are obtained with projection * view.
+         * @return The frustum.
+         */
+        static Frustum FromMatrix(const glm::mat4 &viewProjection);
+
+        /**
+         * @brief Checks whether a sphere is at least partially inside the frustum.
+         * @param sphere Sphere in the same space as the frustum.
+         * @return False if the sphere is entirely outside of one plane.
+         */
+        bool Intersects(const BoundingSphere &sphere) const;
+
+        /**
+         * @brief Checks whether a box is at least partially inside the frustum.
+         * @param box Box in the same space as the frustum.
+         * @return False if the box is entirely outside of one plane.
+         */
+        bool Intersects(const AABB &box) const;
+    };
+}
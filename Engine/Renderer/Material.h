@@ -42,30 +42,87 @@ namespace DT
         Texture::Type textureType = Texture::Type::DIFFUSE;
         Resource<Shader> shader;
 
-        static inline std::unordered_map<RID, Material *> factoryData;
+        /**
+         * @brief Handles to the material uniforms of the material's shader.
+         */
+        struct Uniforms
+        {
+            Uniform<glm::vec3> diffuseColor;
+            Uniform<glm::vec3> specularColor;
+            Uniform<glm::vec3> ambientColor;
+            Uniform<float> shininess;
+            Uniform<int> diffuse;
+            Uniform<int> specular;
+            Uniform<int> normal;
+            Uniform<int> height;
+        };
+
+        /**
+         * @brief Returns the uniform handles of the current shader, resolving them only when the shader changes.
+         */
+        const Uniforms &GetUniforms()
+        {
+            if (uniformsShader != shader.data)
+            {
+                uniformsShader = shader.data;
+                uniforms.diffuseColor = uniformsShader->GetUniform<glm::vec3>("material.diffuseColor");
+                uniforms.specularColor = uniformsShader->GetUniform<glm::vec3>("material.specularColor");
+                uniforms.ambientColor = uniformsShader->GetUniform<glm::vec3>("material.ambientColor");
+                uniforms.shininess = uniformsShader->GetUniform<float>("material.shininess");
+                uniforms.diffuse = uniformsShader->GetUniform<int>("material.diffuse");
+                uniforms.specular = uniformsShader->GetUniform<int>("material.specular");
+                uniforms.normal = uniformsShader->GetUniform<int>("material.normal");
+                uniforms.height = uniformsShader->GetUniform<int>("material.height");
+            }
+            return uniforms;
+        }
+
+        /**
+         * @brief Drops the cached uniform handles, called when the shader was relinked in place and its locations may have moved.
+         */
+        void InvalidateUniforms()
+        {
+            uniformsShader = nullptr;
+        }
 
-        static Material *LoadResource(RID rid, ContextPtr &ctx)
+        /**
+         * @brief Calls a function on every resource handle the material holds, used to load them with the material.
+         */
+        template <typename Function>
+        void ForEachDependency(Function function)
         {
-            if (factoryData.count(rid))
-                return factoryData[rid];
+            function(texture);
+            function(shader);
+        }
+
+        static constexpr const char *typeName = "Material";
 
-            factoryData[rid] = new Material(json::parse(std::ifstream(ctx.resourceManager->GetPath(rid))));
-            return factoryData[rid];
+        static Material *ReadResource(const std::filesystem::path &path)
+        {
+            FileView file = VirtualFileSystem::Open(path);
+            return new Material(json::parse(file.AsString()));
         }
 
-        static void UnLoadResource(RID rid)
+        static void UploadResource(Material *material, ContextPtr &ctx)
         {
-            delete factoryData[rid];
-            factoryData.erase(rid);
+            // Materials have no GPU data of their own
         }
 
         static void SaveResource(RID rid, ContextPtr &ctx)
         {
+            Material *material = ResourceCache::Find<Material>(rid);
+            if (material == nullptr)
+                return;
+
             std::ofstream out(ctx.resourceManager->GetPath(rid));
-            json j = *factoryData[rid];
+            json j = *material;
             out << j;
         }
 
         IN_SERIALIZE(Material, diffuseColor, specularColor, ambientColor, shininess, texture, textureType, shader);
+
+    private:
+        Uniforms uniforms;
+        Shader *uniformsShader = nullptr; /// @brief Shader the cached uniform handles belong to.
     };
 }
\ No newline at end of file
@@ -20,88 +20,486 @@ the following email address:material
 aryanbaburajan2007@gmail.com
 */
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
 #include <Renderer/Mesh.h>
 
 namespace DT
 {
-    void Mesh::Draw(const glm::mat4 &model, Renderer &renderer)
+    namespace
+    {
+        // Decompresses a blob of a pack entry into the buffer bound to target through a write only mapping
+        bool StreamBuffer(GLenum target, PackStream &stream, uint64_t offset, size_t size)
+        {
+            glBufferData(target, (GLsizeiptr)size, nullptr, GL_STATIC_DRAW);
+            if (size == 0)
+                return true;
+
+            void *destination = glMapBufferRange(target, 0, (GLsizeiptr)size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (destination == nullptr)
+                return false;
+
+            bool read = stream.Seek(static_cast<size_t>(offset)) && stream.Read(destination, size) == size;
+            return glUnmapBuffer(target) == GL_TRUE && read;
+        }
+    }
+
+    MeshLOD Mesh::GetLOD(unsigned int lod) const
+    {
+        if (lods.empty())
+            return {0, indexCount, 0.f};
+        return lods[std::min<size_t>(lod, lods.size() - 1)];
+    }
+
+    void Mesh::DrawInstanced(unsigned int firstInstance, unsigned int instanceCount, Renderer &renderer, unsigned int lod)
     {
         // Bind appropriate textures
         for (unsigned int i = 0; i < materials.size(); i++)
         {
-            glActiveTexture(GL_TEXTURE0 + i);
-
             Material *material = materials[i].data;
             Shader *shader = material->shader.data;
-            renderer.ActivateShader(shader);
+            renderer.UseShader(shader);
 
             Texture::Type type = material->textureType;
+            const Material::Uniforms &uniforms = material->GetUniforms();
 
-            shader->Use();
-            shader->SetVec3("material.diffuseColor", material->diffuseColor);
-            shader->SetVec3("material.specularColor", material->specularColor);
-            shader->SetVec3("material.ambientColor", material->ambientColor);
-            shader->SetFloat("material.shininess", material->shininess);
-            shader->SetMat4("model", model);
+            shader->Set(uniforms.diffuseColor, material->diffuseColor);
+            shader->Set(uniforms.specularColor, material->specularColor);
+            shader->Set(uniforms.ambientColor, material->ambientColor);
+            shader->Set(uniforms.shininess, material->shininess);
 
-            shader->SetInt("material.diffuse", i);
+            shader->Set(uniforms.diffuse, (int)i);
             if (type == Texture::Type::DIFFUSE)
-                shader->SetInt("material.diffuse", i);
+                shader->Set(uniforms.diffuse, (int)i);
             else if (type == Texture::Type::SPECULAR)
-                shader->SetInt("material.specular", i);
+                shader->Set(uniforms.specular, (int)i);
             else if (type == Texture::Type::NORMAL)
-                shader->SetInt("material.normal", i);
+                shader->Set(uniforms.normal, (int)i);
             else if (type == Texture::Type::HEIGHT)
-                shader->SetInt("material.height", i);
-            glBindTexture(GL_TEXTURE_2D, material->texture.data->id);
+                shader->Set(uniforms.height, (int)i);
+            renderer.BindTexture(i, material->texture.data->id);
         }
 
-        // Draw mesh
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+        // Draw all instances, model matrices are read from the renderer's instance buffer starting at firstInstance
+        renderer.BindVertexArray(VAO);
+        GLenum indexType = indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        MeshLOD range = GetLOD(lod);
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, range.indexCount, indexType, (void *)((size_t)range.firstIndex * indexSize), instanceCount, firstInstance);
+    }
+
+    void Mesh::Delete()
+    {
+        if (VAO == 0)
+            return;
 
-        // Good practice to set everything back to defaults once configured.
-        glBindVertexArray(0);
-        glActiveTexture(GL_TEXTURE0);
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+        if (skinVBO != 0)
+            glDeleteBuffers(1, &skinVBO);
+        VAO = VBO = EBO = skinVBO = 0;
     }
 
-    void Mesh::Setup()
+    size_t Mesh::GetCPUMemory() const
     {
+        return sizeof(Mesh) + vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int) +
+               materials.capacity() * sizeof(Resource<Material>) + lods.capacity() * sizeof(MeshLOD) + mappedFile.size;
+    }
+
+    size_t Mesh::GetGPUMemory() const
+    {
+        if (VAO == 0)
+            return 0;
+        return (size_t)vertexCount * (MeshFile::VertexStride(layout) + (skinVBO != 0 ? sizeof(SkinVertex) : 0)) + (size_t)indexCount * indexSize;
+    }
+
+    void Mesh::ComputeBounds()
+    {
+        if (vertices.empty())
+        {
+            bounds = AABB();
+            boundingSphere = BoundingSphere();
+            return;
+        }
+
+        bounds.min = bounds.max = vertices[0].position;
+        for (const Vertex &vertex : vertices)
+        {
+            bounds.min = glm::min(bounds.min, vertex.position);
+            bounds.max = glm::max(bounds.max, vertex.position);
+        }
+
+        // Centered on the box, tighter than the box's circumscribed sphere for most meshes
+        boundingSphere.center = bounds.Center();
+        float radiusSquared = 0.f;
+        for (const Vertex &vertex : vertices)
+        {
+            glm::vec3 offset = vertex.position - boundingSphere.center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        boundingSphere.radius = std::sqrt(radiusSquared);
+    }
+
+    void Mesh::ChooseLayout()
+    {
+        skinned = false;
+        bool uvsFitHalf = true;
+        for (const Vertex &vertex : vertices)
+        {
+            for (int i = 0; i < MAX_BONE_INFLUENCE; i++)
+                skinned |= vertex.weights[i] > 0.f;
+
+            // Half floats lose about a texel of a 1024 texture per unit past 4, keep tiled meshes at full precision
+            uvsFitHalf &= std::abs(vertex.texCoords.x) <= 4.f && std::abs(vertex.texCoords.y) <= 4.f;
+        }
+
+        layout = uvsFitHalf ? VertexLayout::Compact : VertexLayout::Standard;
+        indexSize = vertices.size() < 65536 ? sizeof(uint16_t) : sizeof(unsigned int);
+    }
+
+    std::vector<uint8_t> Mesh::PackVertices() const
+    {
+        std::vector<uint8_t> packed(vertices.size() * MeshFile::VertexStride(layout));
+        if (layout == VertexLayout::Compact)
+        {
+            CompactVertex *compact = reinterpret_cast<CompactVertex *>(packed.data());
+            for (size_t i = 0; i < vertices.size(); i++)
+                compact[i] = CompactVertex::FromVertex(vertices[i]);
+        }
+        else if (!vertices.empty())
+            std::memcpy(packed.data(), vertices.data(), packed.size());
+        return packed;
+    }
+
+    std::vector<uint8_t> Mesh::PackIndices() const
+    {
+        std::vector<uint8_t> packed(indices.size() * indexSize);
+        if (indexSize == sizeof(uint16_t))
+        {
+            uint16_t *shortIndices = reinterpret_cast<uint16_t *>(packed.data());
+            for (size_t i = 0; i < indices.size(); i++)
+                shortIndices[i] = static_cast<uint16_t>(indices[i]);
+        }
+        else if (!indices.empty())
+            std::memcpy(packed.data(), indices.data(), packed.size());
+        return packed;
+    }
+
+    std::vector<SkinVertex> Mesh::PackSkin() const
+    {
+        std::vector<SkinVertex> skin;
+        if (layout != VertexLayout::Compact || !skinned)
+            return skin;
+
+        skin.reserve(vertices.size());
+        for (const Vertex &vertex : vertices)
+            skin.push_back(SkinVertex::FromVertex(vertex));
+        return skin;
+    }
+
+    bool Mesh::WriteBinary(const std::filesystem::path &path) const
+    {
+        std::vector<uint8_t> packedVertices = PackVertices();
+        std::vector<SkinVertex> packedSkin = PackSkin();
+        std::vector<uint8_t> packedIndices = PackIndices();
+
+        MeshFile::Header header = {};
+        std::memcpy(header.magic, MeshFile::magic, sizeof(header.magic));
+        header.version = MeshFile::version;
+        header.vertexLayout = static_cast<uint32_t>(layout);
+        header.vertexStride = MeshFile::VertexStride(layout);
+        header.vertexCount = static_cast<uint32_t>(vertices.size());
+        header.indexCount = static_cast<uint32_t>(indices.size());
+        header.indexSize = indexSize;
+        header.materialCount = static_cast<uint32_t>(materials.size());
+        header.skinned = !packedSkin.empty();
+        header.lodCount = static_cast<uint32_t>(lods.size());
+        header.vertexOffset = MeshFile::Align(sizeof(MeshFile::Header));
+        header.skinOffset = MeshFile::Align(header.vertexOffset + packedVertices.size());
+        header.indexOffset = MeshFile::Align(header.skinOffset + packedSkin.size() * sizeof(SkinVertex));
+        header.materialOffset = MeshFile::Align(header.indexOffset + packedIndices.size());
+        header.lodOffset = MeshFile::Align(header.materialOffset + materials.size() * sizeof(RID));
+        header.bounds = bounds;
+        header.boundingSphere = boundingSphere;
+
+        std::vector<RID> materialRIDs;
+        for (const Resource<Material> &material : materials)
+            materialRIDs.push_back(material.rid);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cout << "[ERR] [MESH_WRITE_FAIL] [" << path.string() << "]\n";
+            return false;
+        }
+
+        auto padTo = [&out](uint64_t offset)
+        {
+            while (static_cast<uint64_t>(out.tellp()) < offset)
+                out.put(0);
+        };
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        padTo(header.vertexOffset);
+        out.write(reinterpret_cast<const char *>(packedVertices.data()), packedVertices.size());
+        padTo(header.skinOffset);
+        out.write(reinterpret_cast<const char *>(packedSkin.data()), packedSkin.size() * sizeof(SkinVertex));
+        padTo(header.indexOffset);
+        out.write(reinterpret_cast<const char *>(packedIndices.data()), packedIndices.size());
+        padTo(header.materialOffset);
+        out.write(reinterpret_cast<const char *>(materialRIDs.data()), materialRIDs.size() * sizeof(RID));
+        padTo(header.lodOffset);
+        out.write(reinterpret_cast<const char *>(lods.data()), lods.size() * sizeof(MeshLOD));
+
+        return out.good();
+    }
+
+    Mesh *Mesh::LoadBinary(const std::filesystem::path &path)
+    {
+        FileView file = VirtualFileSystem::Open(path);
+        if (!file.IsOpen())
+            return nullptr;
+
+        return LoadBinary(file, path);
+    }
+
+    Mesh *Mesh::LoadBinary(const FileView &file, const std::filesystem::path &path)
+    {
+        MeshFile::Header header;
+        if (file.size < sizeof(header))
+        {
+            std::cout << "[ERR] [MESH_CORRUPT] [" << path.string() << "]\n";
+            return nullptr;
+        }
+        std::memcpy(&header, file.data, sizeof(header));
+
+        Mesh *mesh = FromHeader(header, file.size, path);
+        if (mesh == nullptr)
+            return nullptr;
+
+        mesh->mappedVertices = file.data + header.vertexOffset;
+        if (header.skinned)
+            mesh->mappedSkin = reinterpret_cast<const SkinVertex *>(file.data + header.skinOffset);
+        mesh->mappedIndices = file.data + header.indexOffset;
+        mesh->mappedFile = file;
+
+        if (!mesh->SetTables(header, reinterpret_cast<const RID *>(file.data + header.materialOffset), reinterpret_cast<const MeshLOD *>(file.data + header.lodOffset), path))
+        {
+            delete mesh;
+            return nullptr;
+        }
+        return mesh;
+    }
+
+    Mesh *Mesh::LoadBinary(const std::shared_ptr<PackStream> &stream, const MeshFile::Header &header, const std::filesystem::path &path)
+    {
+        Mesh *mesh = FromHeader(header, stream->GetSize(), path);
+        if (mesh == nullptr)
+            return nullptr;
+
+        // The tables come last, the blobs before them are skipped without being decompressed
+        std::vector<RID> materialRIDs(header.materialCount);
+        std::vector<MeshLOD> meshLODs(header.lodCount);
+        size_t materialSize = materialRIDs.size() * sizeof(RID), lodSize = meshLODs.size() * sizeof(MeshLOD);
+        bool read = stream->Seek(static_cast<size_t>(header.materialOffset)) && stream->Read(materialRIDs.data(), materialSize) == materialSize &&
+                    stream->Seek(static_cast<size_t>(header.lodOffset)) && stream->Read(meshLODs.data(), lodSize) == lodSize;
+        if (!read)
+        {
+            std::cout << "[ERR] [MESH_CORRUPT] [" << path.string() << "]\n";
+            delete mesh;
+            return nullptr;
+        }
+
+        if (!mesh->SetTables(header, materialRIDs.data(), meshLODs.data(), path))
+        {
+            delete mesh;
+            return nullptr;
+        }
+
+        mesh->stream = stream;
+        mesh->streamHeader = header;
+        return mesh;
+    }
+
+    Mesh *Mesh::FromHeader(const MeshFile::Header &header, uint64_t fileSize, const std::filesystem::path &path)
+    {
+        VertexLayout layout = static_cast<VertexLayout>(header.vertexLayout);
+        if (header.version != MeshFile::version ||
+            (layout != VertexLayout::Standard && layout != VertexLayout::Compact) ||
+            header.vertexStride != MeshFile::VertexStride(layout) ||
+            (header.indexSize != sizeof(uint16_t) && header.indexSize != sizeof(unsigned int)))
+        {
+            std::cout << "[ERR] [MESH_VERSION_MISMATCH] [" << path.string() << "] Re-import the model.\n";
+            return nullptr;
+        }
+
+        if (header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride > fileSize ||
+            (header.skinned && header.skinOffset + (uint64_t)header.vertexCount * sizeof(SkinVertex) > fileSize) ||
+            header.indexOffset + (uint64_t)header.indexCount * header.indexSize > fileSize ||
+            header.materialOffset + (uint64_t)header.materialCount * sizeof(RID) > fileSize ||
+            header.lodOffset + (uint64_t)header.lodCount * sizeof(MeshLOD) > fileSize)
+        {
+            std::cout << "[ERR] [MESH_CORRUPT] [" << path.string() << "]\n";
+            return nullptr;
+        }
+
+        Mesh *mesh = new Mesh();
+        mesh->vertexCount = header.vertexCount;
+        mesh->indexCount = header.indexCount;
+        mesh->bounds = header.bounds;
+        mesh->boundingSphere = header.boundingSphere;
+        mesh->layout = layout;
+        mesh->skinned = header.skinned;
+        mesh->indexSize = header.indexSize;
+        return mesh;
+    }
+
+    bool Mesh::SetTables(const MeshFile::Header &header, const RID *materialRIDs, const MeshLOD *meshLODs, const std::filesystem::path &path)
+    {
+        materials.resize(header.materialCount);
+        for (unsigned int i = 0; i < header.materialCount; i++)
+            materials[i].rid = materialRIDs[i];
+
+        lods.assign(meshLODs, meshLODs + header.lodCount);
+        for (const MeshLOD &lod : lods)
+        {
+            if ((uint64_t)lod.firstIndex + lod.indexCount > header.indexCount)
+            {
+                std::cout << "[ERR] [MESH_CORRUPT] [" << path.string() << "]\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Mesh::Setup(Renderer &renderer)
+    {
+        // Meshes are shared between MeshRenderers, only set them up once
+        if (VAO != 0)
+            return;
+
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        renderer.BindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+        // Binary meshes are uploaded straight from the file mapping, in-memory ones are packed here
+        std::vector<uint8_t> packedVertices;
+        std::vector<SkinVertex> packedSkin;
+        const void *vertexData = mappedVertices;
+        const SkinVertex *skinData = mappedSkin;
+        std::vector<uint8_t> packedIndices;
+        const void *indexData = mappedIndices;
+        if (!mappedFile.IsOpen() && stream == nullptr)
+        {
+            packedVertices = PackVertices();
+            packedSkin = PackSkin();
+            vertexData = packedVertices.data();
+            skinData = packedSkin.empty() ? nullptr : packedSkin.data();
+            packedIndices = PackIndices();
+            indexData = packedIndices.data();
+            vertexCount = static_cast<unsigned int>(vertices.size());
+            indexCount = static_cast<unsigned int>(indices.size());
+        }
+
+        GLsizei stride = MeshFile::VertexStride(layout);
+        bool streamed = true;
+        if (stream != nullptr)
+        {
+            // Compressed pack entries are decompressed straight into the mapped buffers, nothing is staged on the heap
+            streamed = StreamBuffer(GL_ARRAY_BUFFER, *stream, streamHeader.vertexOffset, (size_t)vertexCount * stride);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+            streamed = StreamBuffer(GL_ELEMENT_ARRAY_BUFFER, *stream, streamHeader.indexOffset, (size_t)indexCount * indexSize) && streamed;
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount * stride, vertexData, GL_STATIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount * indexSize, indexData, GL_STATIC_DRAW);
+        }
 
         // set the vertex attribute pointers
-        // vertex Positions
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)0);
-        // vertex normals
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
-        // vertex texture coords
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, texCoords));
-        // vertex tangent
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, tangent));
-        // vertex bitangent
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, bitangent));
-        // ids
-        glEnableVertexAttribArray(5);
-        glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void *)offsetof(Vertex, boneIDs));
-        // weights
-        glEnableVertexAttribArray(6);
-        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, weights));
-        glBindVertexArray(0);
+        if (layout == VertexLayout::Compact)
+        {
+            // vertex Positions
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(CompactVertex, position));
+            // vertex normals, the shader reads xyz of the normalized 10_10_10_2 value
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void *)offsetof(CompactVertex, normal));
+            // vertex texture coords
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void *)offsetof(CompactVertex, texCoords));
+            // vertex tangent, w is the bitangent sign. Unlike the full layout no bitangent is bound at location 4, a
+            // shader that needs it computes cross(normal, tangent.xyz) * tangent.w. The default shader reads neither.
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void *)offsetof(CompactVertex, tangent));
+
+            if (skinData != nullptr || (stream != nullptr && skinned))
+            {
+                glGenBuffers(1, &skinVBO);
+                glBindBuffer(GL_ARRAY_BUFFER, skinVBO);
+                if (stream != nullptr)
+                    streamed = StreamBuffer(GL_ARRAY_BUFFER, *stream, streamHeader.skinOffset, vertexCount * sizeof(SkinVertex)) && streamed;
+                else
+                    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(SkinVertex), skinData, GL_STATIC_DRAW);
+                // ids
+                glEnableVertexAttribArray(5);
+                glVertexAttribIPointer(5, 4, GL_UNSIGNED_SHORT, sizeof(SkinVertex), (void *)offsetof(SkinVertex, boneIDs));
+                // weights
+                glEnableVertexAttribArray(6);
+                glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SkinVertex), (void *)offsetof(SkinVertex, weights));
+            }
+        }
+        else
+        {
+            // vertex Positions
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
+            // vertex normals
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, normal));
+            // vertex texture coords
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, texCoords));
+            // vertex tangent
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, tangent));
+            // vertex bitangent
+            glEnableVertexAttribArray(4);
+            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, bitangent));
+            // ids
+            glEnableVertexAttribArray(5);
+            glVertexAttribIPointer(5, 4, GL_INT, stride, (void *)offsetof(Vertex, boneIDs));
+            // weights
+            glEnableVertexAttribArray(6);
+            glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(Vertex, weights));
+        }
+
+        // The GPU has its own copy now
+        mappedVertices = nullptr;
+        mappedSkin = nullptr;
+        mappedIndices = nullptr;
+        mappedFile = FileView();
+        if (!streamed)
+            std::cout << "[ERR] [MESH_CORRUPT] A compressed mesh blob ended early, the mesh draws garbage until re-imported.\n";
+        stream = nullptr;
+
+        // instance model matrix, one column per attribute location
+        glBindBuffer(GL_ARRAY_BUFFER, renderer.instanceVBO);
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            glEnableVertexAttribArray(7 + i);
+            glVertexAttribPointer(7 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void *)(i * sizeof(glm::vec4)));
+            glVertexAttribDivisor(7 + i, 1);
+        }
+        renderer.BindVertexArray(0);
     }
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ aryanbaburajan2007@gmail.com
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include <Renderer/Vertex.h>
 #include <Renderer/Material.h>
@@ -33,6 +34,11 @@ aryanbaburajan2007@gmail.com
 #include <Core/ResourceManager.h>
 #include <Core/Resource.h>
 #include <Renderer/Renderer.h>
+#include <Renderer/Bounds.h>
+#include <Renderer/MeshFile.h>
+#include <Core/Platform.h>
+#include <Core/VirtualFileSystem.h>
+#include <Core/PackFile.h>
 
 namespace DT
 {
@@ -45,42 +51,184 @@ namespace DT
         std::vector<Vertex> vertices;      /// @brief vector of Vertex objects
         std::vector<unsigned int> indices; /// @brief vector of indices of vertices vector
         std::vector<Resource<Material>> materials;
-        static inline std::unordered_map<RID, Mesh *> factoryData;
+        std::vector<MeshLOD> lods;         /// @brief ranges of indices for each level of detail, finest first, empty when indices is a single LOD
+        static constexpr const char *typeName = "Mesh";
 
-        unsigned int VBO; /// @brief id of vertex buffer object
-        unsigned int EBO; /// @brief id of element array buffer object
-        unsigned int VAO; /// @brief id of vertex array buffer object
+        unsigned int VBO = 0; /// @brief id of vertex buffer object
+        unsigned int EBO = 0; /// @brief id of element array buffer object
+        unsigned int VAO = 0; /// @brief id of vertex array buffer object
+        unsigned int skinVBO = 0; /// @brief id of the SkinVertex buffer object, compact skinned meshes only
+
+        VertexLayout layout = VertexLayout::Standard; /// @brief format the vertices are uploaded and stored in
+        bool skinned = false;                         /// @brief whether the vertices carry bone weights
+        uint32_t indexSize = sizeof(unsigned int);    /// @brief size of an uploaded index, 2 for meshes with fewer than 65536 vertices
+
+        AABB bounds;                   /// @brief model space bounding box, computed on load
+        BoundingSphere boundingSphere; /// @brief model space bounding sphere, computed on load
+
+        unsigned int vertexCount = 0; /// @brief number of vertices uploaded by Setup
+        unsigned int indexCount = 0;  /// @brief number of indices drawn by DrawInstanced
+
+        FileView mappedFile;                              /// @brief binary mesh file backing mappedVertices and mappedIndices, released once uploaded
+        const void *mappedVertices = nullptr;             /// @brief vertex blob inside mappedFile in layout, used instead of vertices when set
+        const SkinVertex *mappedSkin = nullptr;           /// @brief skin blob inside mappedFile, set for compact skinned meshes
+        const void *mappedIndices = nullptr;              /// @brief index blob inside mappedFile in indexSize, used instead of indices when set
+        std::shared_ptr<PackStream> stream;               /// @brief compressed pack entry Setup decompresses the blobs from straight into the GL buffers, used instead of mappedFile when set
+        MeshFile::Header streamHeader = {};               /// @brief header of the streamed file, locates the blobs in stream
 
         /**
-         * @brief Draws the mesh with given shader object
-         * @param shader Shader object to use while drawing
+         * @brief Draws several instances of the mesh in a single draw call
+         * @param firstInstance index of the first model matrix in the renderer's instance buffer
+         * @param instanceCount number of instances to draw
+         * @param renderer Renderer owning the instance buffer
+         * @param lod level of detail to draw, 0 is the full mesh
          */
-        void Draw(const glm::mat4 &model, Renderer &renderer);
+        void DrawInstanced(unsigned int firstInstance, unsigned int instanceCount, Renderer &renderer, unsigned int lod = 0);
+
+        /**
+         * @brief number of levels of detail, at least 1
+         */
+        unsigned int GetLODCount() const { return lods.empty() ? 1 : static_cast<unsigned int>(lods.size()); }
+
+        /**
+         * @brief index range of a level of detail
+         */
+        MeshLOD GetLOD(unsigned int lod) const;
 
         /**
          * @brief sets up the VAOs (Vertex Array Objects) for the mesh
+         * @param renderer Renderer whose instance buffer feeds the per-instance model matrix
+         */
+        void Setup(Renderer &renderer);
+
+        /**
+         * @brief deletes the GL buffers created by Setup
+         */
+        void Delete();
+
+        /**
+         * @brief bytes of CPU memory held by the mesh, including its file mapping
+         */
+        size_t GetCPUMemory() const;
+
+        /**
+         * @brief bytes of video memory held by the mesh's buffers
+         */
+        size_t GetGPUMemory() const;
+
+        /**
+         * @brief calls a function on the handle of every material of the mesh, used to load them with the mesh
+         */
+        template <typename Function>
+        void ForEachDependency(Function function)
+        {
+            for (Resource<Material> &material : materials)
+                function(material);
+        }
+
+        /**
+         * @brief computes bounds and boundingSphere from the vertices
+         */
+        void ComputeBounds();
+
+        /**
+         * @brief picks the most compact vertex layout that keeps the vertices within their precision budget, the
+         * smallest index size that can address them, and sets skinned
          */
-        void Setup();
+        void ChooseLayout();
 
-        static Mesh *LoadResource(RID rid, ContextPtr &ctx)
+        /**
+         * @brief converts vertices to layout
+         * @return the vertex blob as uploaded to the GPU
+         */
+        std::vector<uint8_t> PackVertices() const;
+
+        /**
+         * @brief converts indices to indexSize
+         * @return the index blob as uploaded to the GPU
+         */
+        std::vector<uint8_t> PackIndices() const;
+
+        /**
+         * @brief extracts the skinning stream of a compact skinned mesh
+         */
+        std::vector<SkinVertex> PackSkin() const;
+
+        /**
+         * @brief writes the mesh in the binary MeshFile format
+         * @param path destination of the mesh
+         * @return whether the file was written
+         */
+        bool WriteBinary(const std::filesystem::path &path) const;
+
+        /**
+         * @brief maps a binary mesh, the vertex and index blobs are used in place without being copied or parsed
+         * @param path path of the mesh
+         * @return the mesh, nullptr if the file is not a valid binary mesh
+         */
+        static Mesh *LoadBinary(const std::filesystem::path &path);
+
+        /**
+         * @brief loads a binary mesh from an opened file, the vertex and index blobs are used in place
+         * @param file contents of the mesh, kept alive until the mesh is uploaded
+         * @param path path of the mesh, for error messages
+         * @return the mesh, nullptr if the file is not a valid binary mesh
+         */
+        static Mesh *LoadBinary(const FileView &file, const std::filesystem::path &path);
+
+        /**
+         * @brief loads a binary mesh stored compressed in a pack, only the material and LOD tables are decompressed
+         * here, Setup decompresses the vertex and index blobs straight into the GL buffers
+         * @param stream the pack entry, kept until the mesh is uploaded
+         * @param header header read from the start of stream
+         * @param path path of the mesh, for error messages
+         * @return the mesh, nullptr if the file is not a valid binary mesh
+         */
+        static Mesh *LoadBinary(const std::shared_ptr<PackStream> &stream, const MeshFile::Header &header, const std::filesystem::path &path);
+
+        static Mesh *ReadResource(const std::filesystem::path &path)
         {
-            if (factoryData.count(rid))
-                return factoryData[rid];
+            if (std::shared_ptr<PackStream> stream = VirtualFileSystem::OpenStream(path))
+            {
+                MeshFile::Header header;
+                if (stream->Read(&header, sizeof(header)) == sizeof(header) && MeshFile::IsMeshFile(reinterpret_cast<const unsigned char *>(&header), sizeof(header)))
+                    return LoadBinary(stream, header, path);
+            }
+
+            FileView file = VirtualFileSystem::Open(path);
+
+            // Binary meshes share the .dtmesh extension with the older JSON ones
+            if (MeshFile::IsMeshFile(file.data, file.size))
+                return LoadBinary(file, path);
 
-            factoryData[rid] = new Mesh(json::parse(std::ifstream(ctx.resourceManager->GetPath(rid))));
-            return factoryData[rid];
+            Mesh *mesh = new Mesh(json::parse(file.AsString()));
+            mesh->ComputeBounds();
+            return mesh;
         }
 
-        static void UnLoadResource(RID rid)
+        static void UploadResource(Mesh *mesh, ContextPtr &ctx)
         {
-            delete factoryData[rid];
-            factoryData.erase(rid);
+            mesh->Setup(*ctx.renderer);
         }
+
         static void SaveResource(RID rid, ContextPtr &ctx)
         {
             // yet to be implemented
         }
 
         IN_SERIALIZE(Mesh, vertices, indices, materials);
+
+    private:
+        /**
+         * @brief validates a binary mesh header and creates the mesh it describes, without its blobs and tables
+         * @param fileSize size of the whole file
+         */
+        static Mesh *FromHeader(const MeshFile::Header &header, uint64_t fileSize, const std::filesystem::path &path);
+
+        /**
+         * @brief sets the material handles and LODs from the tables of a binary mesh
+         * @return whether every LOD is within the indices
+         */
+        bool SetTables(const MeshFile::Header &header, const RID *materialRIDs, const MeshLOD *meshLODs, const std::filesystem::path &path);
     };
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#include <Renderer/Bounds.h>
+#include <Renderer/Vertex.h>
+
+namespace DT
+{
+    /**
+     * @brief Level of detail of a mesh, a range of its index buffer drawn with the shared vertices.
+     */
+    struct MeshLOD
+    {
+        uint32_t firstIndex = 0; /// @brief First index of the LOD in the index buffer.
+        uint32_t indexCount = 0; /// @brief Number of indices of the LOD.
+        float error = 0.f;       /// @brief Largest distance the simplified surface moved, in model units.
+        uint32_t padding = 0;    /// @brief Keeps the struct 16 bytes, always 0.
+    };
+
+    /**
+     * @brief Binary mesh container (.dtmesh) laid out so it can be memory mapped and uploaded without parsing.
+     *
+     * Layout: Header, then the vertex blob, the skin blob (compact skinned meshes only), the index blob and the material
+     * RIDs and the LOD table, each starting on an alignment boundary. The index blob holds the indices of every LOD back to back.
+     * Offsets are measured from the start of the file, everything is little endian.
+     */
+    namespace MeshFile
+    {
+        constexpr char magic[4] = {'D', 'T', 'M', 'B'}; /// @brief First four bytes of every binary mesh.
+        constexpr uint32_t version = 4;                  /// @brief Bumped whenever the layout changes, older files have to be re-imported.
+        constexpr uint64_t alignment = 16;               /// @brief Alignment of every blob in the file.
+
+        struct Header
+        {
+            char magic[4];                 /// @brief Always MeshFile::magic.
+            uint32_t version;              /// @brief MeshFile::version the file was written with.
+            uint32_t vertexLayout;         /// @brief VertexLayout of the vertex blob.
+            uint32_t vertexStride;         /// @brief Size of a vertex in bytes, must match the layout's vertex struct.
+            uint32_t vertexCount;          /// @brief Number of vertices in the vertex blob.
+            uint32_t indexCount;           /// @brief Number of indices in the index blob.
+            uint32_t indexSize;            /// @brief Size of an index in bytes, 2 or 4.
+            uint32_t materialCount;        /// @brief Number of material RIDs.
+            uint32_t skinned;              /// @brief Whether the skin blob holds one SkinVertex per vertex.
+            uint32_t lodCount;             /// @brief Number of MeshLOD entries, 0 for meshes without LODs.
+            uint64_t vertexOffset;         /// @brief Offset of the vertex blob.
+            uint64_t skinOffset;           /// @brief Offset of the skin blob.
+            uint64_t indexOffset;          /// @brief Offset of the index blob.
+            uint64_t materialOffset;       /// @brief Offset of the material RIDs.
+            uint64_t lodOffset;            /// @brief Offset of the LOD table.
+            AABB bounds;                   /// @brief Model space bounding box.
+            BoundingSphere boundingSphere; /// @brief Model space bounding sphere.
+        };
+
+        /**
+         * @brief size of one vertex in the given layout
+         */
+        inline uint32_t VertexStride(VertexLayout layout)
+        {
+            return layout == VertexLayout::Compact ? sizeof(CompactVertex) : sizeof(Vertex);
+        }
+
+        /**
+         * @brief rounds an offset up to the next alignment boundary
+         */
+        inline uint64_t Align(uint64_t offset)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief checks the magic bytes of file contents to tell binary meshes from JSON ones
+         * @param data contents of the mesh
+         * @param size size of the contents in bytes
+         * @return whether the contents are a binary mesh
+         */
+        inline bool IsMeshFile(const unsigned char *data, size_t size)
+        {
+            return size >= sizeof(magic) && std::memcmp(data, magic, sizeof(magic)) == 0;
+        }
+
+        /**
+         * @brief checks the magic bytes of a file to tell binary meshes from JSON ones
+         * @param path path of the mesh
+         * @return whether the file is a binary mesh
+         */
+        inline bool IsMeshFile(const std::filesystem::path &path)
+        {
+            char fileMagic[4] = {};
+            std::ifstream in(path, std::ios::binary);
+            in.read(fileMagic, sizeof(fileMagic));
+            return in.gcount() == sizeof(fileMagic) && std::memcmp(fileMagic, magic, sizeof(magic)) == 0;
+        }
+    }
+}
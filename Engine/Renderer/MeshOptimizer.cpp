@@ -0,0 +1,555 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include <Renderer/MeshOptimizer.h>
+
+namespace DT
+{
+    namespace MeshOptimizer
+    {
+        constexpr int forsythCacheSize = 32; /// @brief LRU size the vertex cache optimizer scores against.
+
+        struct VertexHash
+        {
+            size_t operator()(const Vertex *vertex) const
+            {
+                // FNV-1a over the raw bytes, Vertex has no padding
+                const unsigned char *bytes = reinterpret_cast<const unsigned char *>(vertex);
+                size_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(Vertex); i++)
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+                return hash;
+            }
+        };
+
+        struct VertexEqual
+        {
+            bool operator()(const Vertex *a, const Vertex *b) const
+            {
+                return std::memcmp(a, b, sizeof(Vertex)) == 0;
+            }
+        };
+
+        static float ForsythScore(int cachePosition, unsigned int valence)
+        {
+            // Vertices without triangles left never need to stay in the cache
+            if (valence == 0)
+                return -1.f;
+
+            float score = 0.f;
+            if (cachePosition >= 0)
+            {
+                // The last triangle's vertices get a fixed score so the optimizer doesn't prefer strips
+                if (cachePosition < 3)
+                    score = 0.75f;
+                else
+                    score = std::pow(1.f - float(cachePosition - 3) / (forsythCacheSize - 3), 1.5f);
+            }
+
+            // Boost vertices with few triangles left to get rid of them quickly
+            return score + 2.f * std::pow(float(valence), -0.5f);
+        }
+
+        CacheStats AnalyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount)
+        {
+            CacheStats stats;
+            if (indices.empty() || vertexCount == 0)
+                return stats;
+
+            std::vector<unsigned int> timestamps(vertexCount, 0);
+            unsigned int time = cacheSize + 1;
+            unsigned int transformed = 0;
+            for (unsigned int index : indices)
+            {
+                if (time - timestamps[index] > cacheSize)
+                {
+                    timestamps[index] = time++;
+                    transformed++;
+                }
+            }
+
+            stats.acmr = float(transformed) / float(indices.size() / 3);
+            stats.atvr = float(transformed) / float(vertexCount);
+            return stats;
+        }
+
+        void DeduplicateVertices(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices)
+        {
+            std::unordered_map<const Vertex *, unsigned int, VertexHash, VertexEqual> unique;
+            unique.reserve(vertices.size());
+
+            std::vector<unsigned int> remap(vertices.size());
+            std::vector<Vertex> result;
+            result.reserve(vertices.size());
+
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                auto [it, inserted] = unique.emplace(&vertices[i], static_cast<unsigned int>(result.size()));
+                if (inserted)
+                    result.push_back(vertices[i]);
+                remap[i] = it->second;
+            }
+
+            for (unsigned int &index : indices)
+                index = remap[index];
+            vertices.swap(result);
+        }
+
+        void OptimizeVertexCache(std::vector<unsigned int> &indices, size_t vertexCount)
+        {
+            size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0)
+                return;
+
+            // Triangles using each vertex, the first valence[v] entries of a vertex's range are the ones not emitted yet
+            std::vector<unsigned int> valence(vertexCount, 0);
+            for (unsigned int index : indices)
+                valence[index]++;
+
+            std::vector<unsigned int> offsets(vertexCount + 1, 0);
+            for (size_t v = 0; v < vertexCount; v++)
+                offsets[v + 1] = offsets[v] + valence[v];
+
+            std::vector<unsigned int> adjacency(indices.size());
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t t = 0; t < triangleCount; t++)
+                for (size_t k = 0; k < 3; k++)
+                    adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+
+            std::vector<float> vertexScores(vertexCount);
+            for (size_t v = 0; v < vertexCount; v++)
+                vertexScores[v] = ForsythScore(-1, valence[v]);
+
+            std::vector<float> triangleScores(triangleCount);
+            for (size_t t = 0; t < triangleCount; t++)
+                triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+            std::vector<bool> emitted(triangleCount, false);
+            std::vector<unsigned int> cache, newCache;
+            std::vector<unsigned int> result;
+            result.reserve(indices.size());
+
+            size_t cursor = 0;
+            long long best = -1;
+            while (result.size() < indices.size())
+            {
+                // Nothing in the cache has triangles left, continue with the next triangle in input order
+                if (best < 0)
+                {
+                    while (emitted[cursor])
+                        cursor++;
+                    best = static_cast<long long>(cursor);
+                }
+
+                emitted[best] = true;
+                newCache.clear();
+                for (size_t k = 0; k < 3; k++)
+                {
+                    unsigned int vertex = indices[best * 3 + k];
+                    result.push_back(vertex);
+                    if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                        newCache.push_back(vertex);
+
+                    unsigned int *begin = adjacency.data() + offsets[vertex];
+                    unsigned int *end = begin + valence[vertex];
+                    unsigned int *it = std::find(begin, end, static_cast<unsigned int>(best));
+                    std::swap(*it, *(end - 1));
+                    valence[vertex]--;
+                }
+
+                // newCache only holds the emitted triangle's vertices here, the rest of the cache moves back behind them
+                size_t emittedVertices = newCache.size();
+                for (unsigned int vertex : cache)
+                    if (std::find(newCache.begin(), newCache.begin() + emittedVertices, vertex) == newCache.begin() + emittedVertices)
+                        newCache.push_back(vertex);
+
+                // Rescore everything that moved in or out of the cache and the triangles using it
+                for (size_t i = 0; i < newCache.size(); i++)
+                {
+                    unsigned int vertex = newCache[i];
+                    int position = i < forsythCacheSize ? static_cast<int>(i) : -1;
+                    float score = ForsythScore(position, valence[vertex]);
+                    float delta = score - vertexScores[vertex];
+                    vertexScores[vertex] = score;
+
+                    for (unsigned int j = 0; j < valence[vertex]; j++)
+                        triangleScores[adjacency[offsets[vertex] + j]] += delta;
+                }
+
+                if (newCache.size() > forsythCacheSize)
+                    newCache.resize(forsythCacheSize);
+
+                best = -1;
+                float bestScore = -1.f;
+                for (unsigned int vertex : newCache)
+                {
+                    for (unsigned int j = 0; j < valence[vertex]; j++)
+                    {
+                        unsigned int triangle = adjacency[offsets[vertex] + j];
+                        if (triangleScores[triangle] > bestScore)
+                        {
+                            bestScore = triangleScores[triangle];
+                            best = triangle;
+                        }
+                    }
+                }
+
+                cache.swap(newCache);
+            }
+
+            indices.swap(result);
+        }
+
+        void OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices, float threshold)
+        {
+            size_t triangleCount = indices.size() / 3;
+            if (triangleCount < 2)
+                return;
+
+            CacheStats original = AnalyzeVertexCache(indices, vertices.size());
+            float targetACMR = original.acmr * threshold;
+
+            // Split into clusters that each reach the target ACMR from a cold cache, so reordering them keeps the cache efficiency
+            std::vector<size_t> clusters = {0};
+            std::vector<unsigned int> timestamps(vertices.size(), 0);
+            unsigned int time = cacheSize + 1;
+            unsigned int clusterMisses = 0;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                for (size_t k = 0; k < 3; k++)
+                {
+                    unsigned int index = indices[t * 3 + k];
+                    if (time - timestamps[index] > cacheSize)
+                    {
+                        timestamps[index] = time++;
+                        clusterMisses++;
+                    }
+                }
+
+                size_t clusterTriangles = t + 1 - clusters.back();
+                if (t + 1 < triangleCount && float(clusterMisses) / float(clusterTriangles) <= targetACMR)
+                {
+                    clusters.push_back(t + 1);
+                    clusterMisses = 0;
+                    time += cacheSize + 1;
+                }
+            }
+            clusters.push_back(triangleCount);
+
+            auto triangleArea = [&](size_t t, glm::vec3 &centroid)
+            {
+                const glm::vec3 &a = vertices[indices[t * 3]].position;
+                const glm::vec3 &b = vertices[indices[t * 3 + 1]].position;
+                const glm::vec3 &c = vertices[indices[t * 3 + 2]].position;
+                centroid = (a + b + c) / 3.f;
+                return glm::cross(b - a, c - a);
+            };
+
+            glm::vec3 meshCentroid(0.f);
+            float meshArea = 0.f;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                glm::vec3 centroid;
+                float area = glm::length(triangleArea(t, centroid));
+                meshCentroid += centroid * area;
+                meshArea += area;
+            }
+            if (meshArea > 0.f)
+                meshCentroid /= meshArea;
+
+            // Clusters facing away from the mesh center are likely in front of the rest, draw them first
+            struct Cluster
+            {
+                size_t begin, end;
+                float sortKey;
+            };
+            std::vector<Cluster> sorted;
+            for (size_t i = 0; i + 1 < clusters.size(); i++)
+            {
+                glm::vec3 clusterCentroid(0.f), clusterNormal(0.f);
+                float clusterArea = 0.f;
+                for (size_t t = clusters[i]; t < clusters[i + 1]; t++)
+                {
+                    glm::vec3 centroid;
+                    glm::vec3 normal = triangleArea(t, centroid);
+                    float area = glm::length(normal);
+                    clusterCentroid += centroid * area;
+                    clusterNormal += normal;
+                    clusterArea += area;
+                }
+                if (clusterArea > 0.f)
+                    clusterCentroid /= clusterArea;
+                float normalLength = glm::length(clusterNormal);
+                float sortKey = normalLength > 0.f ? glm::dot(clusterCentroid - meshCentroid, clusterNormal / normalLength) : 0.f;
+                sorted.push_back({clusters[i], clusters[i + 1], sortKey});
+            }
+
+            std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster &a, const Cluster &b)
+                             { return a.sortKey > b.sortKey; });
+
+            std::vector<unsigned int> result;
+            result.reserve(indices.size());
+            for (const Cluster &cluster : sorted)
+                result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+
+            if (AnalyzeVertexCache(result, vertices.size()).acmr <= targetACMR)
+                indices.swap(result);
+        }
+
+        /**
+         * @brief Symmetric 4x4 matrix measuring squared distances to a set of planes, w is the total weight of the planes.
+         */
+        struct Quadric
+        {
+            double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0, w = 0;
+
+            static Quadric FromPlane(const glm::dvec3 &normal, double distance, double weight)
+            {
+                Quadric q;
+                q.a2 = normal.x * normal.x * weight;
+                q.ab = normal.x * normal.y * weight;
+                q.ac = normal.x * normal.z * weight;
+                q.ad = normal.x * distance * weight;
+                q.b2 = normal.y * normal.y * weight;
+                q.bc = normal.y * normal.z * weight;
+                q.bd = normal.y * distance * weight;
+                q.c2 = normal.z * normal.z * weight;
+                q.cd = normal.z * distance * weight;
+                q.d2 = distance * distance * weight;
+                q.w = weight;
+                return q;
+            }
+
+            Quadric &operator+=(const Quadric &other)
+            {
+                a2 += other.a2, ab += other.ab, ac += other.ac, ad += other.ad, b2 += other.b2;
+                bc += other.bc, bd += other.bd, c2 += other.c2, cd += other.cd, d2 += other.d2, w += other.w;
+                return *this;
+            }
+
+            /// @brief mean squared distance of a point to the planes
+            double Error(const glm::vec3 &point) const
+            {
+                double x = point.x, y = point.y, z = point.z;
+                double error = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x + b2 * y * y + 2 * bc * y * z + 2 * bd * y +
+                               c2 * z * z + 2 * cd * z + d2;
+                return w > 0 ? std::max(error, 0.0) / w : 0.0;
+            }
+        };
+
+        struct PositionHash
+        {
+            size_t operator()(const glm::vec3 &position) const
+            {
+                const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&position);
+                size_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(glm::vec3); i++)
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+                return hash;
+            }
+        };
+
+        std::vector<unsigned int> Simplify(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices, size_t targetIndexCount, float &error)
+        {
+            error = 0.f;
+            std::vector<unsigned int> result = indices;
+            size_t vertexCount = vertices.size();
+
+            // Vertices sharing a position are split along an attribute seam, collapsing them apart would tear the mesh
+            std::unordered_map<glm::vec3, unsigned int, PositionHash> positions;
+            std::vector<unsigned int> positionGroup(vertexCount), groupSize(vertexCount, 0);
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                positionGroup[v] = positions.emplace(vertices[v].position, static_cast<unsigned int>(v)).first->second;
+                groupSize[positionGroup[v]]++;
+            }
+
+            std::vector<bool> locked(vertexCount, false);
+            for (size_t v = 0; v < vertexCount; v++)
+                locked[v] = groupSize[positionGroup[v]] > 1;
+
+            // Edges used by a single triangle are on an open border, keep its outline
+            std::unordered_map<uint64_t, unsigned int> edgeUses;
+            auto edgeKey = [&](unsigned int a, unsigned int b)
+            {
+                uint64_t ga = positionGroup[a], gb = positionGroup[b];
+                return ga < gb ? (ga << 32) | gb : (gb << 32) | ga;
+            };
+            for (size_t i = 0; i < result.size(); i += 3)
+                for (size_t k = 0; k < 3; k++)
+                    edgeUses[edgeKey(result[i + k], result[i + (k + 1) % 3])]++;
+            for (size_t i = 0; i < result.size(); i += 3)
+                for (size_t k = 0; k < 3; k++)
+                    if (edgeUses[edgeKey(result[i + k], result[i + (k + 1) % 3])] == 1)
+                        locked[result[i + k]] = locked[result[i + (k + 1) % 3]] = true;
+
+            std::vector<Quadric> quadrics(vertexCount);
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                glm::dvec3 a = vertices[result[i]].position, b = vertices[result[i + 1]].position, c = vertices[result[i + 2]].position;
+                glm::dvec3 normal = glm::cross(b - a, c - a);
+                double area = glm::length(normal);
+                if (area <= 0.0)
+                    continue;
+                normal /= area;
+
+                Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, a), area);
+                for (size_t k = 0; k < 3; k++)
+                    quadrics[result[i + k]] += plane;
+            }
+
+            struct Collapse
+            {
+                unsigned int from, to;
+                double cost;
+            };
+            std::vector<Collapse> collapses;
+            std::vector<unsigned int> valence, offsets, adjacency;
+            std::vector<bool> touched;
+            std::vector<unsigned int> remap(vertexCount);
+
+            while (result.size() > targetIndexCount)
+            {
+                size_t triangleCount = result.size() / 3;
+
+                valence.assign(vertexCount, 0);
+                for (unsigned int index : result)
+                    valence[index]++;
+                offsets.assign(vertexCount + 1, 0);
+                for (size_t v = 0; v < vertexCount; v++)
+                    offsets[v + 1] = offsets[v] + valence[v];
+                adjacency.resize(result.size());
+                std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t t = 0; t < triangleCount; t++)
+                    for (size_t k = 0; k < 3; k++)
+                        adjacency[fill[result[t * 3 + k]]++] = static_cast<unsigned int>(t);
+
+                collapses.clear();
+                for (size_t i = 0; i < result.size(); i += 3)
+                {
+                    for (size_t k = 0; k < 3; k++)
+                    {
+                        unsigned int a = result[i + k], b = result[i + (k + 1) % 3];
+                        Quadric quadric = quadrics[a];
+                        quadric += quadrics[b];
+                        if (!locked[a])
+                            collapses.push_back({a, b, quadric.Error(vertices[b].position)});
+                        if (!locked[b])
+                            collapses.push_back({b, a, quadric.Error(vertices[a].position)});
+                    }
+                }
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse &x, const Collapse &y)
+                          { return x.cost < y.cost; });
+
+                // Collapse an independent set of edges, each one removes the triangles on both of its sides
+                touched.assign(vertexCount, false);
+                for (size_t v = 0; v < vertexCount; v++)
+                    remap[v] = static_cast<unsigned int>(v);
+
+                size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+                size_t removed = 0;
+                bool collapsed = false;
+                for (const Collapse &collapse : collapses)
+                {
+                    if (removed >= trianglesToRemove)
+                        break;
+                    if (touched[collapse.from] || touched[collapse.to])
+                        continue;
+
+                    // Reject collapses that would flip a triangle around the moving vertex
+                    bool flips = false;
+                    size_t shared = 0;
+                    for (unsigned int j = offsets[collapse.from]; j < offsets[collapse.from + 1] && !flips; j++)
+                    {
+                        unsigned int t = adjacency[j];
+                        unsigned int corner[3] = {result[t * 3], result[t * 3 + 1], result[t * 3 + 2]};
+                        if (corner[0] == collapse.to || corner[1] == collapse.to || corner[2] == collapse.to)
+                        {
+                            shared++;
+                            continue;
+                        }
+
+                        glm::vec3 before = glm::cross(vertices[corner[1]].position - vertices[corner[0]].position, vertices[corner[2]].position - vertices[corner[0]].position);
+                        for (unsigned int &c : corner)
+                            if (c == collapse.from)
+                                c = collapse.to;
+                        glm::vec3 after = glm::cross(vertices[corner[1]].position - vertices[corner[0]].position, vertices[corner[2]].position - vertices[corner[0]].position);
+                        flips = glm::dot(before, after) <= 0.f;
+                    }
+                    if (flips)
+                        continue;
+
+                    remap[collapse.from] = collapse.to;
+                    quadrics[collapse.to] += quadrics[collapse.from];
+                    error = std::max(error, static_cast<float>(std::sqrt(collapse.cost)));
+                    removed += shared;
+                    collapsed = true;
+
+                    // The one-ring changes shape, later collapses this pass would be checked against stale triangles
+                    for (unsigned int j = offsets[collapse.from]; j < offsets[collapse.from + 1]; j++)
+                        for (size_t k = 0; k < 3; k++)
+                            touched[result[adjacency[j] * 3 + k]] = true;
+                }
+
+                if (!collapsed)
+                    break;
+
+                std::vector<unsigned int> simplified;
+                simplified.reserve(result.size());
+                for (size_t i = 0; i < result.size(); i += 3)
+                {
+                    unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+                    if (a != b && b != c && a != c)
+                        simplified.insert(simplified.end(), {a, b, c});
+                }
+                result.swap(simplified);
+            }
+
+            return result;
+        }
+
+        void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices)
+        {
+            std::vector<unsigned int> remap(vertices.size(), UINT_MAX);
+            std::vector<Vertex> result;
+            result.reserve(vertices.size());
+
+            for (unsigned int &index : indices)
+            {
+                if (remap[index] == UINT_MAX)
+                {
+                    remap[index] = static_cast<unsigned int>(result.size());
+                    result.push_back(vertices[index]);
+                }
+                index = remap[index];
+            }
+
+            vertices.swap(result);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Renderer/Vertex.h>
+
+namespace DT
+{
+    /**
+     * @brief Offline optimizations run on imported meshes so they draw with fewer vertex shader invocations and less overdraw.
+     */
+    namespace MeshOptimizer
+    {
+        constexpr unsigned int cacheSize = 16; /// @brief FIFO size used to estimate the post-transform cache, conservative for current GPUs.
+
+        /**
+         * @brief Post-transform vertex cache statistics of an index buffer.
+         */
+        struct CacheStats
+        {
+            float acmr = 0.f; /// @brief Average cache miss ratio, transformed vertices per triangle, 0.5 is the ideal for regular grids.
+            float atvr = 0.f; /// @brief Average transformed vertex ratio, transformed vertices per vertex, 1 is the ideal.
+        };
+
+        /**
+         * @brief simulates a FIFO post-transform cache over the index buffer
+         * @param indices triangle list
+         * @param vertexCount number of vertices the indices refer to
+         */
+        CacheStats AnalyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount);
+
+        /**
+         * @brief merges bitwise identical vertices and remaps the indices
+         */
+        void DeduplicateVertices(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+
+        /**
+         * @brief reorders triangles for the post-transform vertex cache (Forsyth's linear-speed algorithm)
+         */
+        void OptimizeVertexCache(std::vector<unsigned int> &indices, size_t vertexCount);
+
+        /**
+         * @brief reorders clusters of cache optimized triangles so outward facing ones draw first, reducing overdraw
+         * @param threshold how much worse than the input the ACMR is allowed to get, 1.05 allows 5%
+         */
+        void OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices, float threshold = 1.05f);
+
+        /**
+         * @brief simplifies a mesh by collapsing the edges with the lowest quadric error, borders and attribute seams are kept
+         * @param vertices vertices of the mesh, left untouched since collapses move vertices onto existing ones
+         * @param indices triangle list to simplify
+         * @param targetIndexCount number of indices to stop at, the result can be larger if no more edge can be collapsed safely
+         * @param error receives the largest distance a surface moved, in model units
+         * @return the simplified triangle list, indexing into vertices
+         */
+        std::vector<unsigned int> Simplify(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices, size_t targetIndexCount, float &error);
+
+        /**
+         * @brief reorders vertices in the order the indices first use them and drops unreferenced ones
+         */
+        void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+    }
+}
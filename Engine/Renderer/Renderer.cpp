@@ -20,7 +20,12 @@ the following email address:
 aryanbaburajan2007@gmail.com
 */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <Renderer/Renderer.h>
+#include <Renderer/Mesh.h>
 #include <Scene/Scene.h>
 #include <Core/Engine.h>
 
@@ -160,11 +165,53 @@ namespace DT
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
 
+        // Instance buffer, attached to every mesh VAO in Mesh::Setup
+        glGenBuffers(1, &instanceVBO);
+
+        // Uniform buffers, shared by every shader through fixed binding points
+        glGenBuffers(1, &cameraUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, Shader::cameraBlockBinding, cameraUBO);
+
+        glGenBuffers(1, &lightGridUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, lightGridUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(LightGridBlock), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, Shader::lightGridBlockBinding, lightGridUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        // Light lists, grown on demand by CullLights
+        glGenBuffers(1, &pointLightSSBO);
+        glGenBuffers(1, &directionalLightSSBO);
+        glGenBuffers(1, &lightClusterSSBO);
+        glGenBuffers(1, &lightIndexSSBO);
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, pointLightSSBO, pointLightBufferSize, NULL, 0);
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, directionalLightSSBO, directionalLightBufferSize, NULL, 0);
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, lightClusterSSBO, lightClusterBufferSize, NULL, 0);
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, lightIndexSSBO, lightIndexBufferSize, NULL, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Shader::pointLightBufferBinding, pointLightSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Shader::directionalLightBufferBinding, directionalLightSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Shader::lightClusterBufferBinding, lightClusterSSBO);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Shader::lightIndexBufferBinding, lightIndexSSBO);
+
         std::cout << "[LOG] Renderer Constructed\n";
     }
 
     void Renderer::Render(ContextPtr &ctx)
     {
+        stats = RenderStats();
+
+        // Anything may have touched GL state since the last frame (ImGui, resource loading, ...)
+        InvalidateStateCache();
+
+        // Light systems tick after Render, light the frame with what they submitted during the previous one
+        pointLights.swap(submittedPointLights);
+        directionalLights.swap(submittedDirectionalLights);
+        submittedPointLights.clear();
+        submittedDirectionalLights.clear();
+        submittedPointLightIndices.clear();
+        submittedDirectionalLightIndices.clear();
+
         if (ctx.window->GetMinimized())
             return;
 
@@ -178,9 +225,24 @@ namespace DT
         *cameraView = glm::lookAt(*cameraPosition, *cameraPosition + *cameraRotation * glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.0f, 1.0f, 0.0f));
 
         if (*isOrtho)
-            *cameraProjection = glm::ortho(0.f, ctx.window->GetWindowSize().x, 0.f, ctx.window->GetWindowSize().y, 0.1f, 100.0f);
+            *cameraProjection = glm::ortho(0.f, ctx.window->GetWindowSize().x, 0.f, ctx.window->GetWindowSize().y, nearPlane, farPlane);
         else
-            *cameraProjection = glm::perspective(glm::radians(*fov), ctx.window->GetWindowSize().x / ctx.window->GetWindowSize().y, 0.1f, 100.0f);
+            *cameraProjection = glm::perspective(glm::radians(*fov), ctx.window->GetWindowSize().x / ctx.window->GetWindowSize().y, nearPlane, farPlane);
+
+        frustum = Frustum::FromMatrix(*cameraProjection * *cameraView);
+
+        // The orthographic projection maps one unit to one pixel
+        lodProjectionScale = *isOrtho ? 1.f : ctx.window->GetWindowSize().y * 0.5f * (*cameraProjection)[1][1];
+
+        cameraBlock.projection = *cameraProjection;
+        cameraBlock.view = *cameraView;
+        cameraBlock.viewPos = glm::vec4(*cameraPosition, 1.f);
+
+        glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &cameraBlock);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        CullLights(ctx.window->GetWindowSize());
 
         // // Draw skybox TODO: Switch to HDRI
         // glDepthMask(GL_FALSE);
@@ -206,9 +268,9 @@ namespace DT
             glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT);
 
-            screenShader.Use();
-            glBindVertexArray(quadVAO);
-            glBindTexture(GL_TEXTURE_2D, renderTexture);
+            UseShader(&screenShader);
+            BindVertexArray(quadVAO);
+            BindTexture(0, renderTexture);
             glDrawArrays(GL_TRIANGLES, 0, 6);
 
             glBindFramebuffer(GL_FRAMEBUFFER, FBO);
@@ -219,13 +281,20 @@ namespace DT
     Renderer::~Renderer()
     {
         glDeleteFramebuffers(1, &FBO);
+        glDeleteBuffers(1, &instanceVBO);
+        glDeleteBuffers(1, &cameraUBO);
+        glDeleteBuffers(1, &lightGridUBO);
+        glDeleteBuffers(1, &pointLightSSBO);
+        glDeleteBuffers(1, &directionalLightSSBO);
+        glDeleteBuffers(1, &lightClusterSSBO);
+        glDeleteBuffers(1, &lightIndexSSBO);
     }
 
     void Renderer::SetViewport(glm::vec2 viewportsize)
     {
-        glBindTexture(GL_TEXTURE_2D, renderTexture);
+        BindTexture(0, renderTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, viewportsize.x, viewportsize.y, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        BindTexture(0, 0);
 
         glBindRenderbuffer(GL_RENDERBUFFER, RBO);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, viewportsize.x, viewportsize.y);
@@ -237,50 +306,342 @@ namespace DT
     //     skyboxCubemap = Cubemap(paths);
     // }
 
-    bool Renderer::GetFreeDirectionalLightSpot(unsigned int *spot)
+    void Renderer::SubmitPointLight(Entity entity, PointLightData light)
     {
-        for (int i = 0; i < MAX_LIGHT_NO; i++)
+        // Solve constant + linear * d + quadratic * d^2 = intensity / cutoff for the distance d the light fades out at
+        float intensity = std::max(light.diffuse.r, std::max(light.diffuse.g, light.diffuse.b));
+        float c = light.constant - intensity / LIGHT_ATTENUATION_CUTOFF;
+
+        if (intensity <= 0.f)
+            light.radius = 0.f;
+        else if (light.quadratic > 0.f)
+            light.radius = (-light.linear + std::sqrt(light.linear * light.linear - 4.f * light.quadratic * c)) / (2.f * light.quadratic);
+        else if (light.linear > 0.f)
+            light.radius = -c / light.linear;
+        else
+            light.radius = std::numeric_limits<float>::max();
+
+        auto it = submittedPointLightIndices.find(entity);
+        if (it != submittedPointLightIndices.end())
         {
-            if (occupiedDirectionalLights[i] == false)
-            {
-                occupiedDirectionalLights[i] = true;
-                *spot = i;
-                return true;
-            }
+            submittedPointLights[it->second] = light;
+            return;
         }
-        return false;
+
+        submittedPointLightIndices[entity] = static_cast<unsigned int>(submittedPointLights.size());
+        submittedPointLights.push_back(light);
     }
 
-    void Renderer::UnoccupyDirectionalLightSpot(unsigned int spot)
+    void Renderer::SubmitDirectionalLight(Entity entity, const DirectionalLightData &light)
     {
-        occupiedDirectionalLights[spot] = false;
+        auto it = submittedDirectionalLightIndices.find(entity);
+        if (it != submittedDirectionalLightIndices.end())
+        {
+            submittedDirectionalLights[it->second] = light;
+            return;
+        }
+
+        submittedDirectionalLightIndices[entity] = static_cast<unsigned int>(submittedDirectionalLights.size());
+        submittedDirectionalLights.push_back(light);
     }
 
-    bool Renderer::GetFreePointLightSpot(unsigned int *spot)
+    void Renderer::CullLights(glm::vec2 screenSize)
     {
-        for (int i = 0; i < MAX_LIGHT_NO; i++)
+        const unsigned int clusterCount = LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z;
+        const float sliceScale = LIGHT_CLUSTERS_Z / std::log(farPlane / nearPlane);
+
+        lightGridBlock.gridSize = glm::uvec4(LIGHT_CLUSTERS_X, LIGHT_CLUSTERS_Y, LIGHT_CLUSTERS_Z, directionalLights.size());
+        lightGridBlock.depthParams = glm::vec4(nearPlane, farPlane, sliceScale, 0.f);
+        lightGridBlock.screenSize = glm::vec4(screenSize, 0.f, 0.f);
+
+        // Count the lights touching each cluster
+        lightClusters.assign(clusterCount, {0, 0});
+        lightClusterRanges.clear();
+
+        for (unsigned int i = 0; i < pointLights.size(); i++)
         {
-            if (occupiedPointLight[i] == false)
+            LightClusterRange range;
+            if (!GetLightClusterRange(pointLights[i], sliceScale, range))
             {
-                occupiedPointLight[i] = true;
-                *spot = i;
-                return true;
+                stats.culledLights++;
+                continue;
             }
+
+            range.light = i;
+            lightClusterRanges.push_back(range);
+
+            for (unsigned int z = range.min.z; z <= range.max.z; z++)
+                for (unsigned int y = range.min.y; y <= range.max.y; y++)
+                    for (unsigned int x = range.min.x; x <= range.max.x; x++)
+                        lightClusters[x + y * LIGHT_CLUSTERS_X + z * LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y].count++;
+        }
+
+        // Turn the counts into offsets in the index list
+        unsigned int offset = 0;
+        for (LightCluster &cluster : lightClusters)
+        {
+            cluster.offset = offset;
+            offset += cluster.count;
+            cluster.count = 0;
+        }
+
+        // Scatter the light indices into their clusters' ranges
+        lightIndices.resize(offset);
+        for (const LightClusterRange &range : lightClusterRanges)
+            for (unsigned int z = range.min.z; z <= range.max.z; z++)
+                for (unsigned int y = range.min.y; y <= range.max.y; y++)
+                    for (unsigned int x = range.min.x; x <= range.max.x; x++)
+                    {
+                        LightCluster &cluster = lightClusters[x + y * LIGHT_CLUSTERS_X + z * LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y];
+                        lightIndices[cluster.offset + cluster.count++] = range.light;
+                    }
+
+        stats.lights = static_cast<unsigned int>(pointLights.size() + directionalLights.size());
+        stats.lightAssignments = offset;
+
+        glBindBuffer(GL_UNIFORM_BUFFER, lightGridUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightGridBlock), &lightGridBlock);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, pointLightSSBO, pointLightBufferSize, pointLights.data(), pointLights.size() * sizeof(PointLightData));
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, directionalLightSSBO, directionalLightBufferSize, directionalLights.data(), directionalLights.size() * sizeof(DirectionalLightData));
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, lightClusterSSBO, lightClusterBufferSize, lightClusters.data(), lightClusters.size() * sizeof(LightCluster));
+        UploadBuffer(GL_SHADER_STORAGE_BUFFER, lightIndexSSBO, lightIndexBufferSize, lightIndices.data(), lightIndices.size() * sizeof(unsigned int));
+    }
+
+    bool Renderer::GetLightClusterRange(const PointLightData &light, float sliceScale, LightClusterRange &range)
+    {
+        glm::vec3 center = glm::vec3(*cameraView * glm::vec4(light.position, 1.f));
+        float radius = std::min(light.radius, farPlane);
+        float nearDepth = -center.z - radius;
+        float farDepth = -center.z + radius;
+
+        // Behind the camera or past the far plane
+        if (farDepth < nearPlane || nearDepth > farPlane)
+            return false;
+
+        auto slice = [&](float depth)
+        {
+            float slice = std::log(std::max(depth, nearPlane) / nearPlane) * sliceScale;
+            return static_cast<unsigned int>(glm::clamp(slice, 0.f, LIGHT_CLUSTERS_Z - 1.f));
+        };
+        range.min.z = slice(nearDepth);
+        range.max.z = slice(farDepth);
+
+        // A sphere crossing the near plane can cover any part of the screen, bound it only when it lies fully in front
+        glm::vec2 ndcMin(-1.f), ndcMax(1.f);
+        if (nearDepth > nearPlane)
+        {
+            ndcMin = glm::vec2(std::numeric_limits<float>::max());
+            ndcMax = glm::vec2(-std::numeric_limits<float>::max());
+
+            // The projected corners of the sphere's bounding box enclose its projection
+            for (int corner = 0; corner < 8; corner++)
+            {
+                glm::vec3 offset(corner & 1 ? radius : -radius, corner & 2 ? radius : -radius, corner & 4 ? radius : -radius);
+                glm::vec4 clip = *cameraProjection * glm::vec4(center + offset, 1.f);
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+
+            if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+                return false;
+        }
+
+        auto tile = [](float ndc, unsigned int count)
+        {
+            return static_cast<unsigned int>(glm::clamp((ndc * 0.5f + 0.5f) * count, 0.f, count - 1.f));
+        };
+        range.min.x = tile(ndcMin.x, LIGHT_CLUSTERS_X);
+        range.max.x = tile(ndcMax.x, LIGHT_CLUSTERS_X);
+        range.min.y = tile(ndcMin.y, LIGHT_CLUSTERS_Y);
+        range.max.y = tile(ndcMax.y, LIGHT_CLUSTERS_Y);
+
+        return true;
+    }
+
+    void Renderer::UploadBuffer(GLenum target, unsigned int buffer, size_t &capacity, const void *data, size_t size)
+    {
+        glBindBuffer(target, buffer);
+
+        // Storage buffers must not be empty once bound, keep a minimum size
+        if (size > capacity || capacity == 0)
+            capacity = std::max({size, capacity * 2, (size_t)256});
+
+        glBufferData(target, capacity, NULL, GL_STREAM_DRAW);
+        if (size > 0)
+            glBufferSubData(target, 0, size, data);
+
+        glBindBuffer(target, 0);
+    }
+
+    void Renderer::UseShader(Shader *shader)
+    {
+        if (stateCache.program == shader->id)
+        {
+            stats.skippedStateChanges++;
+            return;
         }
-        return false;
+
+        if (Shader::validateOnUse)
+            shader->Validate();
+
+        glUseProgram(shader->id);
+        stateCache.program = shader->id;
+        stats.stateChanges++;
     }
 
-    void Renderer::UnoccupyPointLightSpot(unsigned int spot)
+    void Renderer::BindVertexArray(unsigned int vertexArray)
     {
-        occupiedPointLight[spot] = false;
+        if (stateCache.vertexArray == vertexArray)
+        {
+            stats.skippedStateChanges++;
+            return;
+        }
+
+        glBindVertexArray(vertexArray);
+        stateCache.vertexArray = vertexArray;
+        stats.stateChanges++;
     }
 
-    void Renderer::ActivateShader(Shader *shader)
+    void Renderer::BindTexture(unsigned int unit, unsigned int texture)
     {
-        shader->Use();
-        shader->SetMat4("projection", *cameraProjection);
-        shader->SetMat4("view", *cameraView);
-        shader->SetVec3("viewPos", *cameraPosition);
+        // Units past the cache are always bound
+        bool cached = unit < MAX_CACHED_TEXTURE_UNITS;
+
+        if (cached && stateCache.textures[unit] == texture)
+        {
+            stats.skippedStateChanges++;
+            return;
+        }
+
+        if (stateCache.activeTextureUnit != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            stateCache.activeTextureUnit = unit;
+            stats.stateChanges++;
+        }
+        else
+            stats.skippedStateChanges++;
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        stats.stateChanges++;
+
+        if (cached)
+            stateCache.textures[unit] = texture;
+    }
+
+    void Renderer::InvalidateStateCache()
+    {
+        stateCache.program = RenderStateCache::unknown;
+        stateCache.vertexArray = RenderStateCache::unknown;
+        stateCache.activeTextureUnit = RenderStateCache::unknown;
+        stateCache.textures.fill(RenderStateCache::unknown);
+    }
+
+    void Renderer::Submit(Mesh *mesh, const glm::mat4 &model, unsigned int lod)
+    {
+        Submit(mesh, model, lod, IsCulled(*mesh, model));
+    }
+
+    bool Renderer::IsCulled(const Mesh &mesh, const glm::mat4 &model) const
+    {
+        // The sphere test is cheaper, the box is only tested for spheres that pass
+        return frustumCulling && (!frustum.Intersects(mesh.boundingSphere.Transform(model)) || !frustum.Intersects(mesh.bounds.Transform(model)));
+    }
+
+    void Renderer::Submit(Mesh *mesh, const glm::mat4 &model, unsigned int lod, bool culled)
+    {
+        stats.instances++;
+
+        if (culled)
+        {
+            stats.culledInstances++;
+            return;
+        }
+
+        Material *material = mesh->materials.empty() ? nullptr : mesh->materials[0].data;
+        Shader *shader = material == nullptr ? nullptr : material->shader.data;
+
+        lod = std::min(lod, mesh->GetLODCount() - 1);
+        submissions.push_back({shader, material, mesh, lod, model});
+        stats.visibleInstances++;
+        if (lod > 0)
+            stats.reducedLODInstances++;
+    }
+
+    unsigned int Renderer::SelectLOD(const Mesh &mesh, const glm::mat4 &model, unsigned int currentLOD) const
+    {
+        unsigned int lodCount = mesh.GetLODCount();
+        if (lodCount == 1)
+            return 0;
+
+        BoundingSphere sphere = mesh.boundingSphere.Transform(model);
+        float scale = mesh.boundingSphere.radius > 0.f ? sphere.radius / mesh.boundingSphere.radius : 1.f;
+        float distance = *isOrtho ? 1.f : std::max(glm::distance(sphere.center, glm::vec3(cameraBlock.viewPos)) - sphere.radius, nearPlane);
+        float pixelsPerUnit = lodProjectionScale * scale / distance;
+
+        auto fits = [&](unsigned int lod, float threshold)
+        { return mesh.GetLOD(lod).error * pixelsPerUnit <= threshold; };
+
+        unsigned int lod = 0;
+        for (unsigned int i = 1; i < lodCount; i++)
+            if (fits(i, lodErrorThreshold))
+                lod = i;
+
+        // Going coarser needs the error to be well under the threshold, otherwise instances at the boundary flicker between LODs
+        currentLOD = std::min(currentLOD, lodCount - 1);
+        while (lod > currentLOD && !fits(lod, lodErrorThreshold * (1.f - lodHysteresis)))
+            lod--;
+        return lod;
+    }
+
+    void Renderer::FlushBatches()
+    {
+        if (submissions.empty())
+            return;
+
+        // Sort by shader first, then material, then mesh and LOD so that consecutive batches share as much state as possible
+        std::sort(submissions.begin(), submissions.end(), [](const RenderSubmission &a, const RenderSubmission &b)
+                  {
+                      if (a.shader != b.shader)
+                          return a.shader < b.shader;
+                      if (a.material != b.material)
+                          return a.material < b.material;
+                      if (a.mesh != b.mesh)
+                          return a.mesh < b.mesh;
+                      return a.lod < b.lod; });
+
+        instanceData.clear();
+        batches.clear();
+
+        for (const RenderSubmission &submission : submissions)
+        {
+            if (batches.empty() || batches.back().mesh != submission.mesh || batches.back().lod != submission.lod)
+                batches.push_back({submission.mesh, submission.lod, static_cast<unsigned int>(instanceData.size()), 0});
+
+            instanceData.push_back(submission.model);
+            batches.back().instanceCount++;
+        }
+
+        // Upload model matrices, orphaning the previous frame's storage
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        if (instanceData.size() > instanceBufferCapacity)
+            instanceBufferCapacity = std::max(instanceData.size(), instanceBufferCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, instanceBufferCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instanceData.size() * sizeof(glm::mat4), instanceData.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        for (const RenderBatch &batch : batches)
+        {
+            batch.mesh->DrawInstanced(batch.firstInstance, batch.instanceCount, *this, batch.lod);
+            stats.drawCalls++;
+            stats.triangles += batch.mesh->GetLOD(batch.lod).indexCount / 3 * batch.instanceCount;
+        }
+
+        stats.batches += batches.size();
+        submissions.clear();
     }
 
     void Renderer::FramebufferSizeCallback(GLFWwindow *glfwWindow, int width, int height)
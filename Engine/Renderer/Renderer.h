@@ -22,9 +22,15 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
-#define MAX_LIGHT_NO 25
+#define LIGHT_CLUSTERS_X 16				   // Screen space tiles along x
+#define LIGHT_CLUSTERS_Y 9				   // Screen space tiles along y
+#define LIGHT_CLUSTERS_Z 24				   // Exponential depth slices between the near and far plane
+#define LIGHT_ATTENUATION_CUTOFF (1.f / 256.f) // Attenuated intensity under which a point light is considered out of range
+#define MAX_CACHED_TEXTURE_UNITS 32
 
 #include <array>
+#include <vector>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -32,6 +38,7 @@ aryanbaburajan2007@gmail.com
 
 #include <Renderer/Shader.h>
 #include <Renderer/Texture.h>
+#include <Renderer/Bounds.h>
 #include <Core/Window.h>
 #include <Core/Debug.h>
 #include <Core/Macro.h>
@@ -42,6 +49,138 @@ GLenum glCheckError_(const char *file, int line);
 
 namespace DT
 {
+	class Mesh;
+	struct Material;
+
+	/**
+	 * @brief A single queued mesh instance waiting to be batched.
+	 */
+	struct RenderSubmission
+	{
+		Shader *shader;		/**< Shader of the mesh's first material, used as the primary sort key. */
+		Material *material; /**< First material of the mesh. */
+		Mesh *mesh;			/**< Mesh to draw. */
+		unsigned int lod;	/**< Level of detail of the mesh to draw. */
+		glm::mat4 model;	/**< Model matrix of the instance. */
+	};
+
+	/**
+	 * @brief A run of instances sharing the same (shader, material, mesh, lod) drawn with one instanced call.
+	 */
+	struct RenderBatch
+	{
+		Mesh *mesh;					/**< Mesh drawn by the batch. */
+		unsigned int lod;			/**< Level of detail of the mesh drawn by the batch. */
+		unsigned int firstInstance; /**< Offset of the batch's first model matrix in the instance buffer. */
+		unsigned int instanceCount; /**< Number of instances in the batch. */
+	};
+
+	/**
+	 * @brief Per-frame rendering statistics.
+	 */
+	struct RenderStats
+	{
+		unsigned int instances = 0; /**< Number of mesh instances submitted this frame. */
+		unsigned int visibleInstances = 0; /**< Number of submitted instances inside the camera frustum. */
+		unsigned int culledInstances = 0;  /**< Number of submitted instances skipped by frustum culling. */
+		unsigned int batches = 0;	/**< Number of batches the instances were grouped into. */
+		unsigned int drawCalls = 0; /**< Number of draw calls issued this frame. */
+		unsigned int triangles = 0; /**< Number of triangles drawn this frame. */
+		unsigned int reducedLODInstances = 0; /**< Number of visible instances drawn with a simplified LOD. */
+		unsigned int stateChanges = 0;		  /**< Number of program, vertex array and texture binds issued to GL this frame. */
+		unsigned int skippedStateChanges = 0; /**< Number of binds skipped because the state was already current. */
+		unsigned int lights = 0;			  /**< Number of point and directional lights lit with this frame. */
+		unsigned int culledLights = 0;		  /**< Number of point lights outside of the view frustum. */
+		unsigned int lightAssignments = 0;	  /**< Number of (cluster, point light) pairs, the size of the light index list. */
+	};
+
+	/**
+	 * @brief std140 mirror of the CameraBlock uniform block declared for every shader.
+	 */
+	struct CameraBlock
+	{
+		glm::mat4 projection; /**< Projection matrix of the active camera. */
+		glm::mat4 view;		  /**< View matrix of the active camera. */
+		glm::vec4 viewPos;	  /**< World position of the active camera, w is unused. */
+	};
+
+	/**
+	 * @brief std430 mirror of a PointLight in the PointLightBuffer storage block. Every vec3 is paired with a scalar to fill a 16 byte slot.
+	 */
+	struct PointLightData
+	{
+		glm::vec3 position;
+		float constant = 1.f;
+		glm::vec3 ambient;
+		float linear = 0.f;
+		glm::vec3 diffuse;
+		float quadratic = 1.f;
+		glm::vec3 specular;
+		float radius = 0.f; /**< Distance past which the light falls under LIGHT_ATTENUATION_CUTOFF, computed on submission. */
+	};
+
+	/**
+	 * @brief std430 mirror of a DirectionalLight in the DirectionalLightBuffer storage block.
+	 */
+	struct DirectionalLightData
+	{
+		glm::vec3 direction;
+		float padding0;
+		glm::vec3 ambient;
+		float padding1;
+		glm::vec3 diffuse;
+		float padding2;
+		glm::vec3 specular;
+		float padding3;
+	};
+
+	/**
+	 * @brief std140 mirror of the LightGridBlock uniform block, describes how fragments map to light clusters.
+	 */
+	struct LightGridBlock
+	{
+		glm::uvec4 gridSize;   /**< Number of clusters along x, y and z, w holds the number of directional lights. */
+		glm::vec4 depthParams; /**< Near plane, far plane and the scale turning log(depth / near) into a depth slice. */
+		glm::vec4 screenSize;  /**< Size of the viewport in pixels, zw are unused. */
+	};
+
+	/**
+	 * @brief Range of the light index list holding the point lights that touch a cluster (std430 uvec2).
+	 */
+	struct LightCluster
+	{
+		unsigned int offset; /**< First entry in the light index list. */
+		unsigned int count;	 /**< Number of lights in the cluster. */
+	};
+
+	/**
+	 * @brief Clusters covered by a point light's bounding sphere, inclusive on both ends.
+	 */
+	struct LightClusterRange
+	{
+		unsigned int light; /**< Index of the light in Renderer::pointLights. */
+		glm::uvec3 min;		/**< First cluster along x, y and z. */
+		glm::uvec3 max;		/**< Last cluster along x, y and z. */
+	};
+
+	static_assert(sizeof(CameraBlock) == 144, "CameraBlock must match the std140 layout");
+	static_assert(sizeof(PointLightData) == 64, "PointLightData must match the std430 layout");
+	static_assert(sizeof(DirectionalLightData) == 64, "DirectionalLightData must match the std430 layout");
+	static_assert(sizeof(LightGridBlock) == 48, "LightGridBlock must match the std140 layout");
+
+	/**
+	 * @brief Last GL bindings made through the Renderer, used to skip redundant state changes.
+	 */
+	struct RenderStateCache
+	{
+		static constexpr unsigned int unknown = 0xFFFFFFFF; /**< Marks a binding whose current value is not known. */
+
+		unsigned int program = unknown;										  /**< Currently used program. */
+		unsigned int vertexArray = unknown;									  /**< Currently bound vertex array. */
+		unsigned int activeTextureUnit = unknown;							  /**< Currently active texture unit. */
+		std::array<unsigned int, MAX_CACHED_TEXTURE_UNITS> textures;		  /**< GL_TEXTURE_2D binding of each texture unit. */
+	};
+
 	/**
 	 * @class Renderer
 	 * @brief Handles rendering operations and manages rendering resources.
@@ -62,13 +201,50 @@ namespace DT
 		glm::quat *cameraRotation = nullptr;								/**< Pointer to the rotation of the camera. */
 		bool *isOrtho = nullptr;											/**< Pointer to a boolean indicating if the camera is in orthographic mode. */
 		float *fov = nullptr;												/**< Pointer to the field of view of the camera. */
-		std::array<bool, MAX_LIGHT_NO> occupiedDirectionalLights = {false}; /**< Array to track occupied directional light spots. */
-		std::array<bool, MAX_LIGHT_NO> occupiedPointLight = {false};		/**< Array to track occupied point light spots. */
+		float nearPlane = 0.1f;												/**< Distance of the camera's near plane. */
+		float farPlane = 100.0f;											/**< Distance of the camera's far plane. */
+		Frustum frustum;													/**< World space frustum of the camera, updated every frame. */
+		bool frustumCulling = true;											/**< Whether Submit skips instances outside of the frustum. */
+		float lodErrorThreshold = 1.f;										/**< Largest simplification error, in pixels, SelectLOD lets an LOD show on screen. */
+		float lodHysteresis = 0.25f;										/**< Fraction the error has to drop under lodErrorThreshold before switching to a coarser LOD. */
+		float lodProjectionScale = 1.f;										/**< Pixels covered by one world unit at a distance of one unit, updated every frame. */
 
 		Shader screenShader;
 		Shader skyboxShader;
 		glm::vec2 customViewportSize; /**< Custom viewport size. */
 
+		unsigned int instanceVBO = 0;				   /**< Per-frame buffer holding the model matrices of every batched instance. */
+		size_t instanceBufferCapacity = 0;			   /**< Number of model matrices the instance buffer can currently hold. */
+		std::vector<RenderSubmission> submissions;	   /**< Instances queued since the last flush. */
+		std::vector<glm::mat4> instanceData;		   /**< CPU side staging of the instance buffer. */
+		std::vector<RenderBatch> batches;			   /**< Batches built by the last flush. */
+		RenderStats stats;							   /**< Statistics of the current frame. */
+		RenderStateCache stateCache;				   /**< Bindings made through UseShader, BindVertexArray and BindTexture. */
+
+		unsigned int cameraUBO = 0;	   /**< Uniform buffer backing CameraBlock, bound to Shader::cameraBlockBinding. */
+		unsigned int lightGridUBO = 0; /**< Uniform buffer backing LightGridBlock, bound to Shader::lightGridBlockBinding. */
+		CameraBlock cameraBlock;	   /**< CPU side copy of the camera uniform block, uploaded once per frame. */
+		LightGridBlock lightGridBlock; /**< CPU side copy of the light grid uniform block, uploaded once per frame. */
+
+		unsigned int pointLightSSBO = 0;	   /**< Storage buffer holding pointLights, bound to Shader::pointLightBufferBinding. */
+		unsigned int directionalLightSSBO = 0; /**< Storage buffer holding directionalLights, bound to Shader::directionalLightBufferBinding. */
+		unsigned int lightClusterSSBO = 0;	   /**< Storage buffer holding lightClusters, bound to Shader::lightClusterBufferBinding. */
+		unsigned int lightIndexSSBO = 0;	   /**< Storage buffer holding lightIndices, bound to Shader::lightIndexBufferBinding. */
+		size_t pointLightBufferSize = 0;	   /**< Capacity of pointLightSSBO in bytes. */
+		size_t directionalLightBufferSize = 0; /**< Capacity of directionalLightSSBO in bytes. */
+		size_t lightClusterBufferSize = 0;	   /**< Capacity of lightClusterSSBO in bytes. */
+		size_t lightIndexBufferSize = 0;	   /**< Capacity of lightIndexSSBO in bytes. */
+
+		std::vector<PointLightData> pointLights;								   /**< Point lights lit with this frame. */
+		std::vector<DirectionalLightData> directionalLights;					   /**< Directional lights lit with this frame. */
+		std::vector<PointLightData> submittedPointLights;						   /**< Point lights submitted for the next frame. */
+		std::vector<DirectionalLightData> submittedDirectionalLights;			   /**< Directional lights submitted for the next frame. */
+		std::unordered_map<Entity, unsigned int> submittedPointLightIndices;	   /**< Slot of each submitted point light, so that an entity is only lit once per frame. */
+		std::unordered_map<Entity, unsigned int> submittedDirectionalLightIndices; /**< Slot of each submitted directional light. */
+		std::vector<LightClusterRange> lightClusterRanges;						   /**< Clusters covered by each visible point light. */
+		std::vector<LightCluster> lightClusters;								   /**< Light index range of every cluster. */
+		std::vector<unsigned int> lightIndices;									   /**< Point light indices, grouped per cluster. */
+
 		bool drawToQuad = true; /**< Flag indicating whether to draw to the quad. */
 
 		/**
@@ -97,36 +273,102 @@ namespace DT
 		// void LoadSkybox(std::array<std::filesystem::path, 6> paths);
 
 		/**
-		 * @brief Retrieves a free spot for a directional light.
-		 * @param spot A pointer to the variable to store the free spot index.
-		 * @return True if a free spot is available, false otherwise.
+		 * @brief Submits a point light to be lit with from the next frame on. Submitting the same entity again in a frame replaces its light.
+		 * @param entity The entity owning the light.
+		 * @param light The light, its radius is computed from the attenuation and color.
+		 */
+		void SubmitPointLight(Entity entity, PointLightData light);
+
+		/**
+		 * @brief Submits a directional light to be lit with from the next frame on. Submitting the same entity again in a frame replaces its light.
+		 * @param entity The entity owning the light.
+		 * @param light The light.
+		 */
+		void SubmitDirectionalLight(Entity entity, const DirectionalLightData &light);
+
+		/**
+		 * @brief Bins the frame's point lights into view space clusters and uploads the light lists for the fragment shaders.
+		 * @param screenSize The size of the viewport in pixels.
+		 */
+		void CullLights(glm::vec2 screenSize);
+
+		/**
+		 * @brief Computes the clusters covered by a point light's bounding sphere.
+		 * @param light The point light.
+		 * @param sliceScale Scale turning log(depth / near) into a depth slice.
+		 * @param range Receives the covered clusters.
+		 * @return False if the light cannot touch any visible cluster.
+		 */
+		bool GetLightClusterRange(const PointLightData &light, float sliceScale, LightClusterRange &range);
+
+		/**
+		 * @brief Uploads data to a buffer, growing it geometrically and orphaning the previous storage otherwise.
+		 * @param target The target to bind the buffer to.
+		 * @param buffer The buffer to upload to.
+		 * @param capacity The current size of the buffer in bytes, updated when the buffer grows.
+		 * @param data The data to upload.
+		 * @param size The size of the data in bytes.
+		 */
+		void UploadBuffer(GLenum target, unsigned int buffer, size_t &capacity, const void *data, size_t size);
+
+		/**
+		 * @brief Makes the shader's program current, skipping the call if it already is.
+		 * @param shader The shader to use.
+		 */
+		void UseShader(Shader *shader);
+
+		/**
+		 * @brief Binds a vertex array, skipping the call if it is already bound.
+		 * @param vertexArray The vertex array to bind.
+		 */
+		void BindVertexArray(unsigned int vertexArray);
+
+		/**
+		 * @brief Binds a 2D texture to a texture unit, skipping the glActiveTexture/glBindTexture calls that are redundant.
+		 * @param unit The texture unit (0 for GL_TEXTURE0).
+		 * @param texture The texture to bind.
+		 */
+		void BindTexture(unsigned int unit, unsigned int texture);
+
+		/**
+		 * @brief Forgets the cached bindings. Must be called after GL state was changed without going through the Renderer.
+		 */
+		void InvalidateStateCache();
+
+		/**
+		 * @brief Queues a mesh instance for batched rendering, unless its bounds are outside of the camera frustum.
+		 * @param mesh The mesh to draw.
+		 * @param model The model matrix of the instance.
+		 * @param lod The level of detail to draw, see SelectLOD.
 		 */
-		bool GetFreeDirectionalLightSpot(unsigned int *spot);
+		void Submit(Mesh *mesh, const glm::mat4 &model, unsigned int lod = 0);
 
 		/**
-		 * @brief Unoccupies a spot for a directional light.
-		 * @param spot The spot index to unoccupy.
+		 * @brief Queues a mesh instance whose visibility the caller already tested with IsCulled, e.g. on the JobSystem.
+		 * @param culled Whether the instance is outside of the camera frustum and skipped.
 		 */
-		void UnoccupyDirectionalLightSpot(unsigned int spot);
+		void Submit(Mesh *mesh, const glm::mat4 &model, unsigned int lod, bool culled);
 
 		/**
-		 * @brief Retrieves a free spot for a point light.
-		 * @param spot A pointer to the variable to store the free spot index.
-		 * @return True if a free spot is available, false
+		 * @brief Whether frustum culling skips a mesh instance. Only reads the renderer, so it's safe to call from several threads.
+		 * @param mesh The mesh to draw.
+		 * @param model The model matrix of the instance.
 		 */
-		bool GetFreePointLightSpot(unsigned int *spot);
+		bool IsCulled(const Mesh &mesh, const glm::mat4 &model) const;
 
 		/**
-		 * @brief Unoccupies a spot for a point light.
-		 * @param spot The spot index to unoccupy.
+		 * @brief Picks the coarsest level of detail whose simplification error stays under lodErrorThreshold pixels on screen.
+		 * @param mesh The mesh to draw.
+		 * @param model The model matrix of the instance.
+		 * @param currentLOD The LOD the instance was drawn with last frame, used for hysteresis.
+		 * @return The LOD to draw the instance with.
 		 */
-		void UnoccupyPointLightSpot(unsigned int spot);
+		unsigned int SelectLOD(const Mesh &mesh, const glm::mat4 &model, unsigned int currentLOD) const;
 
 		/**
-		 * @brief Activates a shader for rendering.
-		 * @param shader A pointer to the shader to activate.
+		 * @brief Groups the queued instances by (shader, material, mesh, lod), uploads their model matrices and issues one instanced draw per group.
 		 */
-		void ActivateShader(Shader *shader);
+		void FlushBatches();
 
 		/**
 		 * @brief Callback function for handling framebuffer size changes.
@@ -27,32 +27,28 @@ namespace DT
 {
     Shader::Shader(RID shaderRID, ContextPtr& ctx)
     {
-        std::filesystem::path shaderPath = ctx.resourceManager->GetPath(shaderRID);
+        shaderPath = ctx.resourceManager->GetPath(shaderRID);
+        ReadSource();
+        Compile();
+    }
 
+    void Shader::ReadSource()
+    {
         // Load the vertex/fragment source code from filePath
-        std::string fShader;
-        std::string vShader;
-        std::ifstream shaderFile;
-
-        shaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            shaderFile.open(shaderPath);
-            std::stringstream shaderStream;
-
-            shaderStream << shaderFile.rdbuf();
-            shaderFile.close();
-            fShader = shaderStream.str();
-            vShader = shaderStream.str();
-        }
-        catch (std::ifstream::failure &e)
+        FileView shaderFile = VirtualFileSystem::Open(shaderPath);
+        if (!shaderFile.IsOpen())
         {
-            std::cout << "[ERR] [SHADER] [FILE_NOT_SUCCESFULLY_READ] [" << shaderPath << "]\n"
-                      << e.what() << std::endl;
+            std::cout << "[ERR] [SHADER] [FILE_NOT_SUCCESFULLY_READ] [" << shaderPath << "]\n";
+            return;
         }
+        source = shaderFile.AsString();
+    }
 
-        vShader = versionInclude + "#define DT_SHADER_VERT\n" + ducktapeInclude + vShader;
-        fShader = versionInclude + "#define DT_SHADER_FRAG\n" + ducktapeInclude + fShader;
+    bool Shader::Compile()
+    {
+        std::string vShader = versionInclude + "#define DT_SHADER_VERT\n" + ducktapeInclude + source;
+        std::string fShader = versionInclude + "#define DT_SHADER_FRAG\n" + ducktapeInclude + source;
+        source.clear();
         const char *vShaderCode = vShader.c_str();
         const char *fShaderCode = fShader.c_str();
 
@@ -71,20 +67,37 @@ namespace DT
         glCompileShader(fragment);
         CheckCompileErrors(fragment, "FRAGMENT", shaderPath);
 
-        // Link program
-        id = glCreateProgram();
-        glAttachShader(id, vertex);
-        glAttachShader(id, fragment);
-        glLinkProgram(id);
-        CheckCompileErrors(id, "PROGRAM", shaderPath);
+        // Link into a new program so a failed relink leaves the previous one in use
+        unsigned int program = glCreateProgram();
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+        glLinkProgram(program);
+        bool linked = CheckCompileErrors(program, "PROGRAM", shaderPath);
 
         // Cleanup the shaders as they already have been linked and thus are no longer needed
         glDeleteShader(vertex);
         glDeleteShader(fragment);
 
+        if (!linked && id != 0)
+        {
+            glDeleteProgram(program);
+            std::cout << "[ERR] [SHADER] [RELINK_FAIL] Keeping the previous program of " << shaderPath.string() << "\n";
+            return false;
+        }
+
+        glDeleteProgram(id);
+        id = program;
+        if (linked)
+        {
+            ReflectUniforms();
+            BindUniformBlocks();
+            Validate();
+        }
+
         loaded = true;
 
         std::cout << "[LOG] Loaded shader at " << shaderPath.string() << "\n";
+        return linked;
     }
 
     Shader::~Shader()
@@ -93,27 +106,157 @@ namespace DT
     }
 
     void Shader::Use()
+    {
+        if (validateOnUse)
+            Validate();
+        glUseProgram(id);
+    }
+
+    bool Shader::Validate()
     {
         GLint valid = GL_FALSE;
         glValidateProgram(id);
         glGetProgramiv(id, GL_VALIDATE_STATUS, &valid);
-        assert(valid == GL_TRUE);
-        glUseProgram(id);
+
+        if (valid != GL_TRUE)
+        {
+            char infoLog[1024];
+            glGetProgramInfoLog(id, 1024, NULL, infoLog);
+            std::cout << "[ERR] [PROGRAM_VALIDATION_ERROR] [" << id << "]\n"
+                      << infoLog << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void Shader::SetBool(const std::string &name, bool value) const
+    {
+        glUniform1i(GetUniformLocation(name), (int)value);
     }
 
-    void Shader::SetBool(std::string name, bool value) const
+    void Shader::SetInt(const std::string &name, int value) const
     {
-        glUniform1i(glGetUniformLocation(id, name.c_str()), (int)value);
+        glUniform1i(GetUniformLocation(name), value);
     }
 
-    void Shader::SetInt(std::string name, int value) const
+    void Shader::SetFloat(const std::string &name, float value) const
     {
-        glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+        glUniform1f(GetUniformLocation(name), value);
+    }
+
+    void Shader::ReflectUniforms()
+    {
+        uniformLocations.clear();
+
+        int uniformCount = 0, maxNameLength = 0;
+        glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::string nameBuffer(maxNameLength, '\0');
+        for (int i = 0; i < uniformCount; i++)
+        {
+            int size = 0, length = 0;
+            GLenum type;
+            glGetActiveUniform(id, i, maxNameLength, &length, &size, &type, nameBuffer.data());
+
+            std::string name(nameBuffer.data(), length);
+            int location = glGetUniformLocation(id, name.c_str());
+
+            // Uniforms inside blocks have no location
+            if (location == -1)
+                continue;
+
+            uniformLocations[name] = location;
+
+            // Arrays of basic types are reported once as "name[0]", register every element and the bare name
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            {
+                std::string baseName = name.substr(0, name.size() - 3);
+                uniformLocations[baseName] = location;
+                for (int element = 1; element < size; element++)
+                {
+                    std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                    uniformLocations[elementName] = glGetUniformLocation(id, elementName.c_str());
+                }
+            }
+        }
     }
 
-    void Shader::SetFloat(std::string name, float value) const
+    void Shader::BindUniformBlocks()
     {
-        glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+        // Blocks the shader does not use are optimized out and report GL_INVALID_INDEX
+        unsigned int cameraBlock = glGetUniformBlockIndex(id, "CameraBlock");
+        if (cameraBlock != GL_INVALID_INDEX)
+            glUniformBlockBinding(id, cameraBlock, cameraBlockBinding);
+
+        unsigned int lightGridBlock = glGetUniformBlockIndex(id, "LightGridBlock");
+        if (lightGridBlock != GL_INVALID_INDEX)
+            glUniformBlockBinding(id, lightGridBlock, lightGridBlockBinding);
+
+        BindStorageBlock("PointLightBuffer", pointLightBufferBinding);
+        BindStorageBlock("DirectionalLightBuffer", directionalLightBufferBinding);
+        BindStorageBlock("LightClusterBuffer", lightClusterBufferBinding);
+        BindStorageBlock("LightIndexBuffer", lightIndexBufferBinding);
+    }
+
+    void Shader::BindStorageBlock(const char *name, unsigned int binding)
+    {
+        unsigned int block = glGetProgramResourceIndex(id, GL_SHADER_STORAGE_BLOCK, name);
+        if (block != GL_INVALID_INDEX)
+            glShaderStorageBlockBinding(id, block, binding);
+    }
+
+    int Shader::GetUniformLocation(const std::string &name) const
+    {
+        auto it = uniformLocations.find(name);
+        if (it == uniformLocations.end())
+            return -1;
+        return it->second;
+    }
+
+    void Shader::Set(Uniform<bool> uniform, bool value) const
+    {
+        glUniform1i(uniform.location, (int)value);
+    }
+
+    void Shader::Set(Uniform<int> uniform, int value) const
+    {
+        glUniform1i(uniform.location, value);
+    }
+
+    void Shader::Set(Uniform<float> uniform, float value) const
+    {
+        glUniform1f(uniform.location, value);
+    }
+
+    void Shader::Set(Uniform<glm::vec2> uniform, const glm::vec2 &value) const
+    {
+        glUniform2fv(uniform.location, 1, &value[0]);
+    }
+
+    void Shader::Set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const
+    {
+        glUniform3fv(uniform.location, 1, &value[0]);
+    }
+
+    void Shader::Set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const
+    {
+        glUniform4fv(uniform.location, 1, &value[0]);
+    }
+
+    void Shader::Set(Uniform<glm::mat2> uniform, const glm::mat2 &value) const
+    {
+        glUniformMatrix2fv(uniform.location, 1, GL_FALSE, &value[0][0]);
+    }
+
+    void Shader::Set(Uniform<glm::mat3> uniform, const glm::mat3 &value) const
+    {
+        glUniformMatrix3fv(uniform.location, 1, GL_FALSE, &value[0][0]);
+    }
+
+    void Shader::Set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const
+    {
+        glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &value[0][0]);
     }
 
     bool Shader::CheckCompileErrors(unsigned int shader, std::string type, const std::filesystem::path &path)
@@ -145,64 +288,48 @@ namespace DT
         return true;
     }
 
-    void Shader::SetVec2(std::string name, const glm::vec2 &value) const
-    {
-        glUniform2fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
-    }
-
-    void Shader::SetVec2(std::string name, float x, float y) const
+    void Shader::SetVec2(const std::string &name, const glm::vec2 &value) const
     {
-        glUniform2f(glGetUniformLocation(id, name.c_str()), x, y);
+        glUniform2fv(GetUniformLocation(name), 1, &value[0]);
     }
 
-    void Shader::SetVec3(std::string name, const glm::vec3 &value) const
+    void Shader::SetVec2(const std::string &name, float x, float y) const
     {
-        glUniform3fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+        glUniform2f(GetUniformLocation(name), x, y);
     }
 
-    void Shader::SetVec3(std::string name, float x, float y, float z) const
+    void Shader::SetVec3(const std::string &name, const glm::vec3 &value) const
     {
-        glUniform3f(glGetUniformLocation(id, name.c_str()), x, y, z);
+        glUniform3fv(GetUniformLocation(name), 1, &value[0]);
     }
 
-    void Shader::SetVec4(std::string name, const glm::vec4 &value) const
+    void Shader::SetVec3(const std::string &name, float x, float y, float z) const
     {
-        glUniform4fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+        glUniform3f(GetUniformLocation(name), x, y, z);
     }
 
-    void Shader::SetVec4(std::string name, float x, float y, float z, float w)
+    void Shader::SetVec4(const std::string &name, const glm::vec4 &value) const
     {
-        glUniform4f(glGetUniformLocation(id, name.c_str()), x, y, z, w);
+        glUniform4fv(GetUniformLocation(name), 1, &value[0]);
     }
 
-    void Shader::SetMat2(std::string name, const glm::mat2 &mat) const
+    void Shader::SetVec4(const std::string &name, float x, float y, float z, float w)
     {
-        glUniformMatrix2fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniform4f(GetUniformLocation(name), x, y, z, w);
     }
 
-    void Shader::SetMat3(std::string name, const glm::mat3 &mat) const
+    void Shader::SetMat2(const std::string &name, const glm::mat2 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 
-    void Shader::SetMat4(std::string name, const glm::mat4 &mat) const
+    void Shader::SetMat3(const std::string &name, const glm::mat3 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-    }
-
-    Shader *Shader::LoadResource(RID rid, ContextPtr& ctx)
-    {
-        if (factoryData.count(rid))
-            return factoryData[rid];
-
-        factoryData[rid] = new Shader(rid, ctx);
-
-        return factoryData[rid];
+        glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 
-    void Shader::UnLoadResource(RID rid)
+    void Shader::SetMat4(const std::string &name, const glm::mat4 &mat) const
     {
-        delete factoryData[rid];
-        factoryData.erase(rid);
+        glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
     }
 }
\ No newline at end of file
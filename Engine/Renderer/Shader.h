@@ -26,6 +26,7 @@ aryanbaburajan2007@gmail.com
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <unordered_map>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -34,11 +35,28 @@ aryanbaburajan2007@gmail.com
 
 #include <Core/Serialization.h>
 #include <Core/ResourceManager.h>
+#include <Core/ResourceCache.h>
+#include <Core/VirtualFileSystem.h>
 #include <Core/Serialization.h>
 #include <Core/ContextPtr.h>
 
 namespace DT
 {
+    /**
+     * @brief Pre-resolved location of a shader uniform, typed by the value it holds.
+     * @tparam T Type of the uniform (bool, int, float, glm::vec2/3/4, glm::mat2/3/4).
+     */
+    template <typename T>
+    struct Uniform
+    {
+        int location = -1; /// @brief Location of the uniform in the program, -1 if it is not active.
+
+        /**
+         * @brief Whether the uniform exists in the program.
+         */
+        bool IsValid() const { return location != -1; }
+    };
+
     /**
      * @brief Shader class for creating and using vertex/fragment shader.
      */
@@ -48,18 +66,35 @@ namespace DT
         unsigned int id = 0; /// @brief Unique id of the shader.
         bool loaded = false; /// @brief Boolean variable about whether the shader has been loaded or not.
 
+        std::unordered_map<std::string, int> uniformLocations; /// @brief Locations of every active uniform, reflected once at link time.
+        std::filesystem::path shaderPath;                      /// @brief Path of the shader source.
+        std::string source;                                    /// @brief Source read by ReadSource, cleared once compiled.
+
+        static constexpr unsigned int cameraBlockBinding = 0;            /// @brief Uniform buffer binding point of the CameraBlock uniform block.
+        static constexpr unsigned int lightGridBlockBinding = 1;         /// @brief Uniform buffer binding point of the LightGridBlock uniform block.
+        static constexpr unsigned int pointLightBufferBinding = 0;       /// @brief Storage buffer binding point of the PointLightBuffer block.
+        static constexpr unsigned int directionalLightBufferBinding = 1; /// @brief Storage buffer binding point of the DirectionalLightBuffer block.
+        static constexpr unsigned int lightClusterBufferBinding = 2;     /// @brief Storage buffer binding point of the LightClusterBuffer block.
+        static constexpr unsigned int lightIndexBufferBinding = 3;       /// @brief Storage buffer binding point of the LightIndexBuffer block.
+
         static inline const std::string versionInclude = "#version 440 core\n";
         static inline const std::string ducktapeInclude = "#ifdef DT_SHADER_FRAG\n"
                                                           "out vec4 FragColor;\n"
                                                           "#endif\n"
 
+                                                          "layout (std140) uniform CameraBlock {\n"
+                                                          "    mat4 projection;\n"
+                                                          "    mat4 view;\n"
+                                                          "    vec4 viewPos;\n"
+                                                          "} camera;\n"
+
                                                           "#ifdef DT_SHADER_VERT\n"
                                                           "#define DT_REGISTER_SHADER() void main() {gl_Position = Vert();}\n"
                                                           "#endif\n"
                                                           "#ifdef DT_SHADER_FRAG\n"
                                                           "#define DT_REGISTER_SHADER() void main() {FragColor = Frag();}\n"
                                                           "#endif\n";
-        static inline std::unordered_map<RID, Shader *> factoryData;
+        static constexpr const char *typeName = "Shader";
 
         Shader() = default;
 
@@ -70,38 +105,46 @@ namespace DT
          */
         ~Shader();
 
+        static inline bool validateOnUse = false; /// @brief Validate the program on every Use() (debugging aid, stalls the pipeline).
+
         /**
          * @brief use the current shader
          */
         void Use();
 
+        /**
+         * @brief validate the program against the current GL state, runs once after linking
+         * @return whether the program is valid
+         */
+        bool Validate();
+
         /**
          * @brief set the boolean variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable
          */
-        void SetBool(std::string name, bool value) const;
+        void SetBool(const std::string &name, bool value) const;
 
         /**
          * @brief set the integer variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable
          */
-        void SetInt(std::string name, int value) const;
+        void SetInt(const std::string &name, int value) const;
 
         /**
          * @brief set the float variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable
          */
-        void SetFloat(std::string name, float value) const;
+        void SetFloat(const std::string &name, float value) const;
 
         /**
          * @brief set the vec2 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::vec2 type.
          */
-        void SetVec2(std::string name, const glm::vec2 &value) const;
+        void SetVec2(const std::string &name, const glm::vec2 &value) const;
 
         /**
          * @brief set the vec2 variable value in the shader
@@ -109,14 +152,14 @@ namespace DT
          * @param x float value to be assigned to the x component of vec2 variable
          * @param y float value to be assigened to the y component of vec2 variable
          */
-        void SetVec2(std::string name, float x, float y) const;
+        void SetVec2(const std::string &name, float x, float y) const;
 
         /**
          * @brief set the vec3 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::vec3 type.
          */
-        void SetVec3(std::string name, const glm::vec3 &value) const;
+        void SetVec3(const std::string &name, const glm::vec3 &value) const;
 
         /**
          * @brief set the vec3 variable value in the shader
@@ -125,14 +168,14 @@ namespace DT
          * @param y float value to be assigned to the y component of vec3 variable.
          * @param z float value to be assigned to the z component of vec3 variable.
          */
-        void SetVec3(std::string name, float x, float y, float z) const;
+        void SetVec3(const std::string &name, float x, float y, float z) const;
 
         /**
          * @brief set the vec4 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::vec4 type.
          */
-        void SetVec4(std::string name, const glm::vec4 &value) const;
+        void SetVec4(const std::string &name, const glm::vec4 &value) const;
 
         /**
          * @brief set the vec4 variable value in the shader
@@ -142,37 +185,118 @@ namespace DT
          * @param z float value to be assigned to the z component of vec4 variable.
          * @param w float value to be assigned to the w component of vec4 variable.
          */
-        void SetVec4(std::string name, float x, float y, float z, float w);
+        void SetVec4(const std::string &name, float x, float y, float z, float w);
 
         /**
          * @brief set the mat2 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::mat2 type.
          */
-        void SetMat2(std::string name, const glm::mat2 &mat) const;
+        void SetMat2(const std::string &name, const glm::mat2 &mat) const;
 
         /**
          * @brief set the mat3 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::mat3 type.
          */
-        void SetMat3(std::string name, const glm::mat3 &mat) const;
+        void SetMat3(const std::string &name, const glm::mat3 &mat) const;
 
         /**
          * @brief set the mat4 variable value in the shader
          * @param name name of the variable
          * @param value value to be assigned to the variable. Should be of glm::mat4 type.
          */
-        void SetMat4(std::string name, const glm::mat4 &mat) const;
+        void SetMat4(const std::string &name, const glm::mat4 &mat) const;
+
+        /**
+         * @brief get the location of an active uniform from the link time cache
+         * @param name name of the variable
+         * @return location of the uniform, -1 if the uniform is not active
+         */
+        int GetUniformLocation(const std::string &name) const;
+
+        /**
+         * @brief get a pre-resolved handle to a uniform, meant to be stored and reused every frame
+         * @param name name of the variable
+         * @return handle to the uniform, invalid if the uniform is not active
+         */
+        template <typename T>
+        Uniform<T> GetUniform(const std::string &name) const
+        {
+            return Uniform<T>{GetUniformLocation(name)};
+        }
+
+        /**
+         * @brief set a uniform through a pre-resolved handle, no string or location lookup involved
+         * @param uniform handle returned by GetUniform
+         * @param value value to be assigned to the variable
+         */
+        void Set(Uniform<bool> uniform, bool value) const;
+        void Set(Uniform<int> uniform, int value) const;
+        void Set(Uniform<float> uniform, float value) const;
+        void Set(Uniform<glm::vec2> uniform, const glm::vec2 &value) const;
+        void Set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const;
+        void Set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const;
+        void Set(Uniform<glm::mat2> uniform, const glm::mat2 &value) const;
+        void Set(Uniform<glm::mat3> uniform, const glm::mat3 &value) const;
+        void Set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const;
+
+        /**
+         * @brief read the source of the shader, doesn't touch GL so it can run on a worker thread
+         */
+        void ReadSource();
 
-        static Shader *LoadResource(RID rid, ContextPtr& ctx);
-        static void UnLoadResource(RID rid);
+        /**
+         * @brief compile and link the source read by ReadSource, must run on the main thread. A program that was
+         * linked before is only replaced if the new one links, so it can be called again to hot reload the shader.
+         * @return whether the program linked
+         */
+        bool Compile();
+
+        static Shader *ReadResource(const std::filesystem::path &path)
+        {
+            Shader *shader = new Shader();
+            shader->shaderPath = path;
+            shader->ReadSource();
+            return shader;
+        }
+        static void UploadResource(Shader *shader, ContextPtr &ctx)
+        {
+            shader->Compile();
+        }
+        static void ReplaceResource(Shader *shader, Shader *reloaded, ContextPtr &ctx)
+        {
+            // Relink in place, materials keep their pointer and the program id only changes if the new source links
+            if (!reloaded->source.empty())
+            {
+                shader->source = std::move(reloaded->source);
+                shader->Compile();
+            }
+            delete reloaded;
+        }
         static void SaveResource(RID rid)
         {
             // yet to be implemented
         }
 
     protected:
+        /**
+         * @brief bind the uniform and storage blocks shared by every shader (camera, light grid and light lists) to their binding points
+         */
+        void BindUniformBlocks();
+
+        /**
+         * @brief bind a storage block to a binding point if the shader uses it
+         * @param name name of the block
+         * @param binding storage buffer binding point
+         */
+        void BindStorageBlock(const char *name, unsigned int binding);
+
         bool CheckCompileErrors(unsigned int shader, std::string type, const std::filesystem::path &path);
+
+        /**
+         * @brief query every active uniform of the linked program and cache its location
+         */
+        void ReflectUniforms();
     };
 }
\ No newline at end of file
@@ -20,22 +20,149 @@ the following email address:
 aryanbaburajan2007@gmail.com
 */
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <Renderer/Texture.h>
+#include <Renderer/Renderer.h>
 
 namespace DT
 {
     Texture::Texture(RID rid, ContextPtr &ctx)
     {
-        stbi_set_flip_vertically_on_load(true);
+        texturePath = ctx.resourceManager->GetPath(rid);
+        Decode();
+        Upload(ctx);
+    }
+
+    void Texture::Decode()
+    {
+        if (OpenCompressed())
+            return;
+
+        // The flip flag is per thread, workers decode too
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        FileView file = VirtualFileSystem::Open(texturePath);
+        pixels = file.data ? stbi_load_from_memory(file.data, static_cast<int>(file.size), &width, &height, &nrChannels, 0) : nullptr;
+
+        if (!pixels)
+        {
+            std::cout << "[ERR] [TEXTURE_LOAD_FAIL] [" << texturePath << "]\n";
+            std::cout << "[ERR] [STBI] " << stbi_failure_reason() << std::endl;
+        }
+    }
+
+    bool Texture::OpenCompressed()
+    {
+        std::filesystem::path compressedPath = TextureFile::GetCompressedPath(texturePath);
+        TextureFile::Header header;
+        FileView file;
+        size_t fileSize;
+        std::shared_ptr<PackStream> stream = VirtualFileSystem::OpenStream(compressedPath);
+        if (stream != nullptr)
+        {
+            // Only the header is decompressed here, the levels go straight to the GPU in Upload
+            if (stream->Read(&header, sizeof(header)) != sizeof(header) || !TextureFile::IsTextureFile(reinterpret_cast<const unsigned char *>(&header), sizeof(header)))
+                return false;
+            fileSize = stream->GetSize();
+        }
+        else
+        {
+            file = VirtualFileSystem::Open(compressedPath);
+            if (!file.IsOpen() || !TextureFile::IsTextureFile(file.data, file.size))
+                return false;
+            std::memcpy(&header, file.data, sizeof(header));
+            fileSize = file.size;
+        }
+
+        // An image edited after it was compressed wins until it's compressed again
+        std::error_code error;
+        std::filesystem::file_time_type imageTime = std::filesystem::last_write_time(texturePath, error);
+        if (!error)
+        {
+            std::filesystem::file_time_type compressedTime = std::filesystem::last_write_time(compressedPath, error);
+            if (!error && imageTime > compressedTime)
+                return false;
+        }
+
+        size_t size = header.dataOffset;
+        for (uint32_t i = 0; i < header.mipCount; i++)
+            size += TextureFile::LevelSize(header.format, std::max(header.width >> i, 1u), std::max(header.height >> i, 1u));
+        if (header.mipCount == 0 || size > fileSize)
+        {
+            std::cout << "[ERR] [TEXTURE_FILE_CORRUPT] [" << compressedPath.string() << "]\n";
+            return false;
+        }
+
+        width = static_cast<int>(header.width);
+        height = static_cast<int>(header.height);
+        nrChannels = static_cast<int>(header.channels);
+        compressed = std::move(file);
+        compressedStream = std::move(stream);
+        compressedHeader = header;
+        return true;
+    }
 
+    void Texture::Upload(ContextPtr &ctx)
+    {
         glGenTextures(1, &id);
 
-        texturePath = ctx.resourceManager->GetPath(rid);
+        if (!pixels && !compressed.IsOpen() && compressedStream == nullptr)
+            return;
+
+        // Textures can be loaded mid-frame, keep the renderer's texture bindings in sync
+        if (ctx.renderer)
+            ctx.renderer->BindTexture(0, id);
+        else
+            glBindTexture(GL_TEXTURE_2D, id);
+
+        if (compressed.IsOpen() || compressedStream != nullptr)
+        {
+            // Every level was compressed at import time, uploaded straight from the mapping or the pack
+            const TextureFile::Header &header = compressedHeader;
+            GLenum format = TextureFile::GLFormat(header.format);
+            size_t chainSize = 0;
+            for (uint32_t i = 0; i < header.mipCount; i++)
+                chainSize += TextureFile::LevelSize(header.format, std::max(header.width >> i, 1u), std::max(header.height >> i, 1u));
+
+            // A chain stored compressed in a pack is decompressed into a pixel unpack buffer, the levels are then
+            // read from it at offsets instead of from client memory
+            unsigned int unpackBuffer = 0;
+            if (compressedStream != nullptr)
+            {
+                glGenBuffers(1, &unpackBuffer);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)chainSize, nullptr, GL_STREAM_DRAW);
+                void *destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)chainSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+                bool read = destination != nullptr && compressedStream->Seek(header.dataOffset) && compressedStream->Read(destination, chainSize) == chainSize;
+                if (destination != nullptr)
+                    read = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE && read;
+                if (!read)
+                    std::cout << "[ERR] [TEXTURE_FILE_CORRUPT] [" << TextureFile::GetCompressedPath(texturePath).string() << "]\n";
+            }
 
-        unsigned char *data = stbi_load(texturePath.string().c_str(), &width, &height, &nrChannels, 0);
+            size_t offset = 0;
+            for (uint32_t i = 0; i < header.mipCount; i++)
+            {
+                uint32_t levelWidth = std::max(header.width >> i, 1u), levelHeight = std::max(header.height >> i, 1u);
+                size_t size = TextureFile::LevelSize(header.format, levelWidth, levelHeight);
+                const void *level = unpackBuffer != 0 ? reinterpret_cast<const void *>(offset) : compressed.data + header.dataOffset + offset;
+                glCompressedTexImage2D(GL_TEXTURE_2D, i, format, levelWidth, levelHeight, 0, static_cast<GLsizei>(size), level);
+                offset += size;
+            }
+            compressedSize += chainSize;
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.mipCount - 1);
 
-        if (data)
+            if (unpackBuffer != 0)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glDeleteBuffers(1, &unpackBuffer);
+            }
+            compressed = FileView();
+            compressedStream = nullptr;
+        }
+        else
         {
             GLenum format;
             if (nrChannels == 1)
@@ -47,30 +174,41 @@ namespace DT
             else
                 format = GL_RGB;
 
-            glBindTexture(GL_TEXTURE_2D, id);
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
             glGenerateMipmap(GL_TEXTURE_2D);
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            stbi_image_free(data);
-        }
-        else
-        {
-            std::cout << "[ERR] [TEXTURE_LOAD_FAIL] [" << texturePath << "]\n";
-            std::cout << "[ERR] [STBI] " << stbi_failure_reason() << std::endl;
-            stbi_image_free(data);
-            return;
+            stbi_image_free(pixels);
+            pixels = nullptr;
         }
 
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
         loaded = true;
     }
 
     void Texture::Delete()
     {
         glDeleteTextures(1, &id);
+        loaded = false;
+    }
+
+    size_t Texture::GetCPUMemory() const
+    {
+        return sizeof(Texture) + (pixels ? (size_t)width * height * nrChannels : 0) + compressed.size;
+    }
+
+    size_t Texture::GetGPUMemory() const
+    {
+        if (!loaded)
+            return 0;
+        if (compressedSize > 0)
+            return compressedSize;
+
+        // Drivers pad RGB to RGBA, the mip chain adds a third
+        size_t texelSize = nrChannels == 3 ? 4 : nrChannels;
+        return (size_t)width * height * texelSize * 4 / 3;
     }
 }
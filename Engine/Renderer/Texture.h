@@ -32,7 +32,11 @@ aryanbaburajan2007@gmail.com
 
 #include <Core/Serialization.h>
 #include <Core/ResourceManager.h>
+#include <Core/ResourceCache.h>
+#include <Core/VirtualFileSystem.h>
+#include <Core/PackFile.h>
 #include <Core/ContextPtr.h>
+#include <Renderer/TextureFile.h>
 
 namespace DT
 {
@@ -48,6 +52,11 @@ namespace DT
         unsigned int id;                   /// @brief Unique id of the texture.
         bool loaded = false;               /// @brief Whether the texture is loaded or not.
         std::filesystem::path texturePath; /// @brief Path to the loaded texture file.
+        unsigned char *pixels = nullptr;   /// @brief Decoded image waiting for Upload, freed once uploaded.
+        FileView compressed;               /// @brief Compressed copy of the image waiting for Upload, released once uploaded.
+        std::shared_ptr<PackStream> compressedStream; /// @brief Compressed copy stored compressed in a pack, Upload decompresses it straight into a pixel unpack buffer. Used instead of compressed when set.
+        TextureFile::Header compressedHeader = {};    /// @brief Header of the compressed copy waiting for Upload.
+        size_t compressedSize = 0;         /// @brief Bytes of video memory of the uploaded compressed mip chain, 0 if the image was uploaded uncompressed.
 
         enum Type
         {
@@ -57,7 +66,7 @@ namespace DT
             HEIGHT
         };
 
-        static inline std::unordered_map<RID, Texture *> factoryData;
+        static constexpr const char *typeName = "Texture";
 
         Texture() = default;
 
@@ -66,19 +75,35 @@ namespace DT
          */
         Texture(RID rid, ContextPtr &ctx);
 
-        static Texture *LoadResource(RID rid, ContextPtr &ctx)
-        {
-            if (factoryData.count(rid))
-                return factoryData[rid];
+        /**
+         * @brief Decodes the image file, doesn't touch GL so it can run on a worker thread. An up to date compressed
+         * copy made by TextureCompressor is mapped instead, it needs no decoding.
+         */
+        void Decode();
+
+        /**
+         * @brief Maps the compressed copy of the image, or opens it as a stream when a pack holds it compressed, if
+         * there is one and it isn't older than the image.
+         * @return whether the compressed copy will be uploaded
+         */
+        bool OpenCompressed();
+
+        /**
+         * @brief Creates the GL texture from the decoded image or the compressed copy, must run on the main thread.
+         */
+        void Upload(ContextPtr &ctx);
 
-            factoryData[rid] = new Texture(rid, ctx);
-            return factoryData[rid];
+        static Texture *ReadResource(const std::filesystem::path &path)
+        {
+            Texture *texture = new Texture();
+            texture->texturePath = path;
+            texture->Decode();
+            return texture;
         }
 
-        static void UnLoadResource(RID rid)
+        static void UploadResource(Texture *texture, ContextPtr &ctx)
         {
-            delete factoryData[rid];
-            factoryData.erase(rid);
+            texture->Upload(ctx);
         }
 
         static void SaveResource(RID rid, ContextPtr &ctx)
@@ -91,6 +116,16 @@ namespace DT
          */
         void Delete();
 
+        /**
+         * @brief bytes of CPU memory held by the texture
+         */
+        size_t GetCPUMemory() const;
+
+        /**
+         * @brief bytes of video memory held by the texture, including its mipmaps
+         */
+        size_t GetGPUMemory() const;
+
         IN_SERIALIZE(Texture, texturePath);
     };
 }
\ No newline at end of file
@@ -0,0 +1,363 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <utils/stb_image.h>
+
+#include <Renderer/TextureCompressor.h>
+
+namespace DT
+{
+    namespace TextureCompressor
+    {
+        namespace
+        {
+            /**
+             * @brief Copies a 4x4 block, pixels past the edge repeat the last row or column.
+             */
+            void FetchBlock(const unsigned char *rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, unsigned char block[16][4])
+            {
+                for (uint32_t y = 0; y < 4; y++)
+                    for (uint32_t x = 0; x < 4; x++)
+                    {
+                        uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+                        uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+                        std::memcpy(block[y * 4 + x], rgba + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+                    }
+            }
+
+            uint16_t To565(const float color[3])
+            {
+                auto quantize = [](float value, int max)
+                { return static_cast<uint16_t>(std::clamp(static_cast<int>(std::lround(value / 255.f * max)), 0, max)); };
+                return static_cast<uint16_t>(quantize(color[0], 31) << 11 | quantize(color[1], 63) << 5 | quantize(color[2], 31));
+            }
+
+            void From565(uint16_t color, int rgb[3])
+            {
+                int r = color >> 11, g = (color >> 5) & 63, b = color & 31;
+                rgb[0] = r << 3 | r >> 2;
+                rgb[1] = g << 2 | g >> 4;
+                rgb[2] = b << 3 | b >> 2;
+            }
+
+            /**
+             * @brief Encodes the RGB of a block, endpoints at the extremes of the block's colors along their principal axis.
+             */
+            void CompressBC1(const unsigned char block[16][4], unsigned char *out)
+            {
+                float mean[3] = {};
+                for (int i = 0; i < 16; i++)
+                    for (int c = 0; c < 3; c++)
+                        mean[c] += block[i][c] / 16.f;
+
+                float covariance[6] = {}; // rr rg rb gg gb bb
+                for (int i = 0; i < 16; i++)
+                {
+                    float d[3] = {block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2]};
+                    covariance[0] += d[0] * d[0];
+                    covariance[1] += d[0] * d[1];
+                    covariance[2] += d[0] * d[2];
+                    covariance[3] += d[1] * d[1];
+                    covariance[4] += d[1] * d[2];
+                    covariance[5] += d[2] * d[2];
+                }
+
+                // Power iteration converges on the principal axis in a few steps for 3x3 matrices
+                float axis[3] = {1.f, 1.f, 1.f};
+                for (int iteration = 0; iteration < 8; iteration++)
+                {
+                    float next[3] = {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                                     covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                                     covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]};
+                    float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+                    if (length < 1e-6f)
+                        break;
+                    for (int c = 0; c < 3; c++)
+                        axis[c] = next[c] / length;
+                }
+
+                float minT = 0.f, maxT = 0.f;
+                for (int i = 0; i < 16; i++)
+                {
+                    float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+
+                float axisLength = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+                float start[3], end[3];
+                for (int c = 0; c < 3; c++)
+                {
+                    start[c] = mean[c] + axis[c] * maxT / std::max(axisLength, 1e-6f);
+                    end[c] = mean[c] + axis[c] * minT / std::max(axisLength, 1e-6f);
+                }
+
+                uint16_t color0 = To565(start), color1 = To565(end);
+                // color0 > color1 selects the four color mode, equal endpoints only need index 0
+                if (color0 < color1)
+                    std::swap(color0, color1);
+
+                uint32_t indices = 0;
+                if (color0 != color1)
+                {
+                    int palette[4][3];
+                    From565(color0, palette[0]);
+                    From565(color1, palette[1]);
+                    for (int c = 0; c < 3; c++)
+                    {
+                        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                    }
+
+                    for (int i = 0; i < 16; i++)
+                    {
+                        int best = 0, bestDistance = INT32_MAX;
+                        for (int j = 0; j < 4; j++)
+                        {
+                            int dr = block[i][0] - palette[j][0], dg = block[i][1] - palette[j][1], db = block[i][2] - palette[j][2];
+                            int distance = dr * dr + dg * dg + db * db;
+                            if (distance < bestDistance)
+                            {
+                                best = j;
+                                bestDistance = distance;
+                            }
+                        }
+                        indices |= static_cast<uint32_t>(best) << (2 * i);
+                    }
+                }
+
+                out[0] = color0 & 0xFF;
+                out[1] = color0 >> 8;
+                out[2] = color1 & 0xFF;
+                out[3] = color1 >> 8;
+                for (int i = 0; i < 4; i++)
+                    out[4 + i] = (indices >> (8 * i)) & 0xFF;
+            }
+
+            /**
+             * @brief Encodes one channel of a block with the eight value ramp between its extremes.
+             */
+            void CompressBC4(const unsigned char block[16][4], int channel, unsigned char *out)
+            {
+                int low = 255, high = 0;
+                for (int i = 0; i < 16; i++)
+                {
+                    low = std::min<int>(low, block[i][channel]);
+                    high = std::max<int>(high, block[i][channel]);
+                }
+
+                // value0 > value1 selects the eight value mode, index 0 is value0 and 1 is value1
+                int palette[8] = {high, low};
+                for (int i = 2; i < 8; i++)
+                    palette[i] = ((8 - i) * high + (i - 1) * low) / 7;
+
+                uint64_t indices = 0;
+                if (high != low)
+                    for (int i = 0; i < 16; i++)
+                    {
+                        int best = 0, bestDistance = INT32_MAX;
+                        for (int j = 0; j < 8; j++)
+                        {
+                            int distance = std::abs(block[i][channel] - palette[j]);
+                            if (distance < bestDistance)
+                            {
+                                best = j;
+                                bestDistance = distance;
+                            }
+                        }
+                        indices |= static_cast<uint64_t>(best) << (3 * i);
+                    }
+
+                out[0] = static_cast<unsigned char>(high);
+                out[1] = static_cast<unsigned char>(low);
+                for (int i = 0; i < 6; i++)
+                    out[2 + i] = (indices >> (8 * i)) & 0xFF;
+            }
+
+            void CompressBlock(const unsigned char block[16][4], TextureFile::Format format, unsigned char *out)
+            {
+                switch (format)
+                {
+                case TextureFile::Format::BC1:
+                    CompressBC1(block, out);
+                    break;
+                case TextureFile::Format::BC3:
+                    CompressBC4(block, 3, out);
+                    CompressBC1(block, out + 8);
+                    break;
+                case TextureFile::Format::BC4:
+                    CompressBC4(block, 0, out);
+                    break;
+                case TextureFile::Format::BC5:
+                    CompressBC4(block, 0, out);
+                    CompressBC4(block, 1, out + 8);
+                    break;
+                }
+            }
+        }
+
+        TextureFile::Format ChooseFormat(const unsigned char *rgba, uint32_t width, uint32_t height, int channels)
+        {
+            if (channels == 1)
+                return TextureFile::Format::BC4;
+
+            // Grey and alpha images are expanded to RGBA, their alpha needs BC3 as well
+            if (channels == 2 || channels == 4)
+                for (size_t i = 0; i < static_cast<size_t>(width) * height; i++)
+                    if (rgba[i * 4 + 3] != 255)
+                        return TextureFile::Format::BC3;
+
+            return TextureFile::Format::BC1;
+        }
+
+        std::vector<unsigned char> Downsample(const unsigned char *rgba, uint32_t width, uint32_t height)
+        {
+            uint32_t halfWidth = std::max(width / 2, 1u), halfHeight = std::max(height / 2, 1u);
+            std::vector<unsigned char> result(static_cast<size_t>(halfWidth) * halfHeight * 4);
+
+            for (uint32_t y = 0; y < halfHeight; y++)
+            {
+                const unsigned char *row0 = rgba + static_cast<size_t>(std::min(y * 2, height - 1)) * width * 4;
+                const unsigned char *row1 = rgba + static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width * 4;
+                for (uint32_t x = 0; x < halfWidth; x++)
+                {
+                    size_t x0 = std::min(x * 2, width - 1) * 4, x1 = std::min(x * 2 + 1, width - 1) * 4;
+                    for (int c = 0; c < 4; c++)
+                        result[(static_cast<size_t>(y) * halfWidth + x) * 4 + c] = static_cast<unsigned char>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+                }
+            }
+
+            return result;
+        }
+
+        std::vector<unsigned char> Compress(const unsigned char *rgba, uint32_t width, uint32_t height, TextureFile::Format format)
+        {
+            uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+            size_t blockSize = TextureFile::BlockSize(format);
+            std::vector<unsigned char> blocks(TextureFile::LevelSize(format, width, height));
+
+            auto compressRows = [&](uint32_t firstRow, uint32_t lastRow)
+            {
+                unsigned char block[16][4];
+                for (uint32_t blockY = firstRow; blockY < lastRow; blockY++)
+                    for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+                    {
+                        FetchBlock(rgba, width, height, blockX, blockY, block);
+                        CompressBlock(block, format, blocks.data() + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize);
+                    }
+            };
+
+            // Small levels aren't worth a thread
+            uint32_t threadCount = std::clamp(std::thread::hardware_concurrency(), 1u, std::max(blocksY / 16, 1u));
+            std::vector<std::thread> threads;
+            uint32_t rowsPerThread = (blocksY + threadCount - 1) / threadCount;
+            for (uint32_t i = 1; i < threadCount; i++)
+                threads.emplace_back(compressRows, std::min(i * rowsPerThread, blocksY), std::min((i + 1) * rowsPerThread, blocksY));
+            compressRows(0, std::min(rowsPerThread, blocksY));
+            for (std::thread &thread : threads)
+                thread.join();
+
+            return blocks;
+        }
+
+        bool WriteTextureFile(const unsigned char *rgba, uint32_t width, uint32_t height, int channels, TextureFile::Format format, const std::filesystem::path &path)
+        {
+            TextureFile::Header header{};
+            std::memcpy(header.magic, TextureFile::magic, sizeof(header.magic));
+            header.version = TextureFile::version;
+            header.format = format;
+            header.width = width;
+            header.height = height;
+            header.mipCount = TextureFile::MipCount(width, height);
+            header.channels = static_cast<uint32_t>(channels);
+            header.dataOffset = sizeof(header);
+
+            // Written next to the destination first so that a failed write never leaves a truncated texture behind
+            std::filesystem::path temporaryPath = path;
+            temporaryPath += ".tmp";
+            {
+                std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+                std::vector<unsigned char> level;
+                const unsigned char *pixels = rgba;
+                for (uint32_t i = 0; i < header.mipCount; i++)
+                {
+                    uint32_t levelWidth = std::max(width >> i, 1u), levelHeight = std::max(height >> i, 1u);
+                    std::vector<unsigned char> blocks = Compress(pixels, levelWidth, levelHeight, format);
+                    out.write(reinterpret_cast<const char *>(blocks.data()), blocks.size());
+
+                    if (i + 1 < header.mipCount)
+                    {
+                        level = Downsample(pixels, levelWidth, levelHeight);
+                        pixels = level.data();
+                    }
+                }
+
+                if (!out)
+                {
+                    std::cout << "[ERR] [TEXTURE_WRITE_FAIL] [" << path.string() << "]\n";
+                    return false;
+                }
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temporaryPath, path, error);
+            return !error;
+        }
+
+        bool IsStale(const std::filesystem::path &imagePath)
+        {
+            std::error_code error;
+            std::filesystem::file_time_type compressedTime = std::filesystem::last_write_time(TextureFile::GetCompressedPath(imagePath), error);
+            if (error)
+                return true;
+            std::filesystem::file_time_type imageTime = std::filesystem::last_write_time(imagePath, error);
+            return !error && imageTime > compressedTime;
+        }
+
+        bool CompressImage(const std::filesystem::path &imagePath)
+        {
+            // Same orientation as Texture::Decode
+            stbi_set_flip_vertically_on_load_thread(true);
+
+            int width, height, channels;
+            unsigned char *rgba = stbi_load(imagePath.string().c_str(), &width, &height, &channels, 4);
+            if (!rgba)
+            {
+                std::cout << "[ERR] [TEXTURE_COMPRESS_FAIL] [" << imagePath.string() << "] " << stbi_failure_reason() << "\n";
+                return false;
+            }
+
+            TextureFile::Format format = ChooseFormat(rgba, width, height, channels);
+            bool written = WriteTextureFile(rgba, width, height, channels, format, TextureFile::GetCompressedPath(imagePath));
+            stbi_image_free(rgba);
+            return written;
+        }
+    }
+}
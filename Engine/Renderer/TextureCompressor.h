@@ -0,0 +1,79 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <Renderer/TextureFile.h>
+
+namespace DT
+{
+    /**
+     * @brief Offline block compression of images into TextureFile containers, run at import time so textures load
+     * without decoding or mip generation and take 4 to 8 times less video memory.
+     */
+    namespace TextureCompressor
+    {
+        /**
+         * @brief picks BC4 for single channel images, BC3 for images with an alpha channel that isn't fully opaque and BC1 otherwise.
+         * Never BC5, which only suits normal maps once a shader samples them and rebuilds Z, materials bind every
+         * texture as their diffuse map for now.
+         * @param rgba pixels expanded to RGBA
+         * @param channels channels of the source image
+         */
+        TextureFile::Format ChooseFormat(const unsigned char *rgba, uint32_t width, uint32_t height, int channels);
+
+        /**
+         * @brief halves an RGBA image with a box filter, the last row or column of odd sizes is averaged with itself
+         * @return the next mip level, at least 1x1
+         */
+        std::vector<unsigned char> Downsample(const unsigned char *rgba, uint32_t width, uint32_t height);
+
+        /**
+         * @brief compresses an RGBA image into 4x4 blocks, spread over every core
+         * @param format BC4 compresses the red channel, BC5 red and green
+         * @return the blocks, TextureFile::LevelSize bytes
+         */
+        std::vector<unsigned char> Compress(const unsigned char *rgba, uint32_t width, uint32_t height, TextureFile::Format format);
+
+        /**
+         * @brief compresses an RGBA image and its whole mip chain into a TextureFile
+         * @param channels channels of the source image, stored in the header
+         * @return whether the file was written
+         */
+        bool WriteTextureFile(const unsigned char *rgba, uint32_t width, uint32_t height, int channels, TextureFile::Format format, const std::filesystem::path &path);
+
+        /**
+         * @brief whether the compressed copy of an image is missing or older than the image
+         */
+        bool IsStale(const std::filesystem::path &imagePath);
+
+        /**
+         * @brief decodes an image and writes its compressed copy to TextureFile::GetCompressedPath
+         * @return whether the copy was written
+         */
+        bool CompressImage(const std::filesystem::path &imagePath);
+    }
+}
@@ -0,0 +1,146 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#include <glad/glad.h>
+
+// S3TC isn't core, every desktop driver exposes EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace DT
+{
+    /**
+     * @brief Block compressed texture container (.dttex) holding a precomputed mip chain, uploaded without decoding.
+     *
+     * Layout: Header, then every mip level from the largest to 1x1, back to back starting at dataOffset. A level is
+     * the rows of 4x4 blocks of the format, top row first in the order the texture is uploaded. Everything is little endian.
+     * The compressed copy of an image is stored next to it, see GetCompressedPath.
+     */
+    namespace TextureFile
+    {
+        constexpr char magic[4] = {'D', 'T', 'T', 'X'}; /// @brief First four bytes of every compressed texture.
+        constexpr uint32_t version = 1;                  /// @brief Bumped whenever the layout changes, older files have to be recompressed.
+
+        /**
+         * @brief Block compression format of the texture.
+         */
+        enum class Format : uint32_t
+        {
+            BC1 = 1, /// @brief Opaque RGB, 8 bytes per block.
+            BC3 = 2, /// @brief RGBA with interpolated alpha, 16 bytes per block.
+            BC4 = 3, /// @brief Single channel, 8 bytes per block.
+            BC5 = 4  /// @brief Two channels, 16 bytes per block.
+        };
+
+        struct Header
+        {
+            char magic[4];       /// @brief Always TextureFile::magic.
+            uint32_t version;    /// @brief TextureFile::version the file was written with.
+            Format format;       /// @brief Block compression format of every level.
+            uint32_t width;      /// @brief Width of the largest level in pixels.
+            uint32_t height;     /// @brief Height of the largest level in pixels.
+            uint32_t mipCount;   /// @brief Number of levels, down to 1x1.
+            uint32_t channels;   /// @brief Channels of the source image.
+            uint32_t padding;    /// @brief Always 0.
+            uint64_t dataOffset; /// @brief Offset of the first level.
+        };
+
+        /**
+         * @brief bytes of one 4x4 block in the given format
+         */
+        inline size_t BlockSize(Format format)
+        {
+            return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+        }
+
+        /**
+         * @brief bytes of a level of the given size, partial blocks at the edges count as whole ones
+         */
+        inline size_t LevelSize(Format format, uint32_t width, uint32_t height)
+        {
+            return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * BlockSize(format);
+        }
+
+        /**
+         * @brief number of levels of a full mip chain, down to 1x1
+         */
+        inline uint32_t MipCount(uint32_t width, uint32_t height)
+        {
+            uint32_t count = 1;
+            for (uint32_t size = std::max(width, height); size > 1; size /= 2)
+                count++;
+            return count;
+        }
+
+        /**
+         * @brief internal format to pass to glCompressedTexImage2D
+         */
+        inline GLenum GLFormat(Format format)
+        {
+            switch (format)
+            {
+            case Format::BC1:
+                return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case Format::BC3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case Format::BC4:
+                return GL_COMPRESSED_RED_RGTC1;
+            case Format::BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            }
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        }
+
+        /**
+         * @brief checks the magic bytes and the version of a file
+         */
+        inline bool IsTextureFile(const unsigned char *data, size_t size)
+        {
+            Header header;
+            if (size < sizeof(header))
+                return false;
+            std::memcpy(&header, data, sizeof(header));
+            return std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == version;
+        }
+
+        /**
+         * @brief path of the compressed copy of an image, the image's path with .dttex appended
+         */
+        inline std::filesystem::path GetCompressedPath(const std::filesystem::path &imagePath)
+        {
+            std::filesystem::path path = imagePath;
+            path += ".dttex";
+            return path;
+        }
+    }
+}
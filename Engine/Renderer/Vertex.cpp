@@ -0,0 +1,67 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/packing.hpp>
+
+#include <Renderer/Vertex.h>
+
+namespace DT
+{
+    CompactVertex CompactVertex::FromVertex(const Vertex &vertex)
+    {
+        CompactVertex compact;
+        compact.position = vertex.position;
+
+        // Imported normals and tangents aren't guaranteed to be unit length, snorm needs them in [-1, 1]
+        glm::vec3 normal = glm::length(vertex.normal) > 0.f ? glm::normalize(vertex.normal) : glm::vec3(0.f);
+        glm::vec3 tangent = glm::length(vertex.tangent) > 0.f ? glm::normalize(vertex.tangent) : glm::vec3(0.f);
+        float handedness = glm::dot(glm::cross(normal, tangent), vertex.bitangent) < 0.f ? -1.f : 1.f;
+
+        compact.normal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.f));
+        compact.tangent = glm::packSnorm3x10_1x2(glm::vec4(tangent, handedness));
+        compact.texCoords = glm::packHalf2x16(vertex.texCoords);
+        return compact;
+    }
+
+    SkinVertex SkinVertex::FromVertex(const Vertex &vertex)
+    {
+        SkinVertex skin;
+        int total = 0;
+        int heaviest = 0;
+        for (int i = 0; i < MAX_BONE_INFLUENCE; i++)
+        {
+            skin.boneIDs[i] = static_cast<uint16_t>(std::max(vertex.boneIDs[i], 0));
+            skin.weights[i] = static_cast<uint8_t>(std::round(glm::clamp(vertex.weights[i], 0.f, 1.f) * 255.f));
+            total += skin.weights[i];
+            if (skin.weights[i] > skin.weights[heaviest])
+                heaviest = i;
+        }
+
+        // Give the rounding error to the heaviest influence so the weights still add up to one
+        if (total > 0)
+            skin.weights[heaviest] = static_cast<uint8_t>(glm::clamp(skin.weights[heaviest] + 255 - total, 0, 255));
+        return skin;
+    }
+}
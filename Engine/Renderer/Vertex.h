@@ -22,6 +22,8 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 #include <Core/Serialization.h>
 
@@ -36,9 +38,54 @@ namespace DT
         glm::vec2 texCoords;                 /// @brief texture coordinate vector corresponding to the vertex
         glm::vec3 tangent;                   /// @brief tangent vector corresponding to the vertex
         glm::vec3 bitangent;                 /// @brief bi-tangent vector corresponding to the vertex
-        int boneIDs[MAX_BONE_INFLUENCE];     /// @brief list of bone IDs
-        float weights[MAX_BONE_INFLUENCE];   /// @brief list of weights
+        int boneIDs[MAX_BONE_INFLUENCE] = {};     /// @brief list of bone IDs
+        float weights[MAX_BONE_INFLUENCE] = {};   /// @brief list of weights
     };
     
     SERIALIZE(Vertex, position, normal, texCoords, tangent, bitangent);
+
+    /**
+     * @brief GPU vertex formats a mesh can be uploaded with, picked per mesh at import time
+     */
+    enum class VertexLayout : uint32_t
+    {
+        Standard = 0, /// @brief Vertex as is, full precision, 88 bytes
+        Compact = 1   /// @brief CompactVertex plus an optional SkinVertex stream, 24 bytes
+    };
+
+    /**
+     * @brief Quantized vertex for static meshes.
+     *
+     * Normals and tangents are snorm 10_10_10_2, texture coordinates are half floats. The bitangent is not stored,
+     * it is cross(normal, tangent.xyz) * tangent.w where tangent.w holds the handedness sign.
+     */
+    struct CompactVertex
+    {
+        glm::vec3 position; /// @brief position vector of the vertex
+        uint32_t normal;    /// @brief normal packed as GL_INT_2_10_10_10_REV, w is unused
+        uint32_t tangent;   /// @brief tangent packed as GL_INT_2_10_10_10_REV, w is the bitangent sign
+        uint32_t texCoords; /// @brief texture coordinates as two half floats
+
+        /**
+         * @brief quantizes a full precision vertex
+         */
+        static CompactVertex FromVertex(const Vertex &vertex);
+    };
+
+    /**
+     * @brief Skinning data of a compact vertex, kept in its own stream so static meshes don't pay for it
+     */
+    struct SkinVertex
+    {
+        uint16_t boneIDs[MAX_BONE_INFLUENCE]; /// @brief list of bone IDs
+        uint8_t weights[MAX_BONE_INFLUENCE];  /// @brief list of weights as unorm8
+
+        /**
+         * @brief quantizes the bone data of a full precision vertex
+         */
+        static SkinVertex FromVertex(const Vertex &vertex);
+    };
+
+    static_assert(sizeof(CompactVertex) == 24, "CompactVertex must stay tightly packed");
+    static_assert(sizeof(SkinVertex) == 12, "SkinVertex must stay tightly packed");
 }
\ No newline at end of file
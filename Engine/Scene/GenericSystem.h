@@ -22,11 +22,25 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <tuple>
+
 #include <Scene/System.h>
 #include <Core/Serialization.h>
 
 namespace DT
 {
+    /**
+     * @brief What the Tick of a component touches besides the component itself, which it is assumed to write.
+     * Specialize it for components whose Tick reads or writes other components, or doesn't need the main thread.
+     */
+    template <typename T>
+    struct SystemTraits
+    {
+        using Reads = std::tuple<>;
+        using Writes = std::tuple<>;
+        static constexpr bool mainThread = true;
+    };
+
     template <typename T>
     class GenericSystem : public System
     {
@@ -40,55 +54,65 @@ namespace DT
         HAS_METHOD_DECL(Serialize);
         HAS_METHOD_DECL(Inspector);
 
+        template <typename... Components>
+        static void DeclareReads(SystemAccess &access, std::tuple<Components...> *) { access.Read<Components...>(); }
+        template <typename... Components>
+        static void DeclareWrites(SystemAccess &access, std::tuple<Components...> *) { access.Write<Components...>(); }
+
     public:
-        GenericSystem(const std::string &compName) : componentName(compName) {}
+        GenericSystem(const std::string &compName) : componentName(compName)
+        {
+            access.Write<T>();
+            DeclareReads(access, (typename SystemTraits<T>::Reads *)nullptr);
+            DeclareWrites(access, (typename SystemTraits<T>::Writes *)nullptr);
+            access.mainThread = SystemTraits<T>::mainThread;
+        }
 
         void Init(ContextPtr &ctx) override
         {
             if constexpr (HasInit<T>::value)
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                    ctx.sceneManager->GetActiveScene().Get<T>(entity)->Init(entity, ctx);
+                for (auto [entity, component] : ctx.sceneManager->GetActiveScene().View<T>().each())
+                    component.Init(entity, ctx);
         }
 
         void Tick(ContextPtr &ctx) override
         {
             if constexpr (HasTick<T>::value)
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                    ctx.sceneManager->GetActiveScene().Get<T>(entity)->Tick(entity, ctx);
+                for (auto [entity, component] : ctx.sceneManager->GetActiveScene().View<T>().each())
+                    component.Tick(entity, ctx);
         }
 
         void SceneView(ContextPtr &ctx) override
         {
             if constexpr (HasSceneView<T>::value)
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                    ctx.sceneManager->GetActiveScene().Get<T>(entity)->SceneView(entity, ctx);
+                for (auto [entity, component] : ctx.sceneManager->GetActiveScene().View<T>().each())
+                    component.SceneView(entity, ctx);
         }
 
         void Destroy(ContextPtr &ctx) override
         {
             if constexpr (HasDestroy<T>::value)
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                    ctx.sceneManager->GetActiveScene().Get<T>(entity)->Destroy(entity, ctx);
+                for (auto [entity, component] : ctx.sceneManager->GetActiveScene().View<T>().each())
+                    component.Destroy(entity, ctx);
         }
 
         void Serialize(ContextPtr &ctx, Entity entity) override
         {
+            // Called once per entity, the components of the other entities get their own call
             if constexpr (HasSerialize<T>::value)
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                    ctx.sceneManager->GetActiveScene().SerializeComponent<T>(componentName, entity, ctx.sceneManager->GetActiveScene());
+            {
+                Scene &scene = ctx.sceneManager->GetActiveScene();
+                scene.SerializeComponent<T>(componentName, entity, scene);
+            }
         }
 
         void Inspector(ContextPtr &ctx, Entity selectedEntity) override
         {
             if constexpr (HasInspector<T>::value)
             {
-                for (Entity entity : ctx.sceneManager->GetActiveScene().View<T>())
-                {
-                    if (entity != selectedEntity)
-                        continue;
-
-                    ctx.sceneManager->GetActiveScene().Get<T>(entity)->Inspector(entity, ctx, selectedEntity);
-                }
+                auto view = ctx.sceneManager->GetActiveScene().View<T>();
+                if (view.contains(selectedEntity))
+                    view.template get<T>(selectedEntity).Inspector(selectedEntity, ctx, selectedEntity);
             }
         }
     };
@@ -21,6 +21,7 @@ aryanbaburajan2007@gmail.com
 */
 
 #include <Scene/Scene.h>
+#include <Core/VirtualFileSystem.h>
 #include <fstream>
 
 namespace DT
@@ -28,7 +29,8 @@ namespace DT
     Scene::Scene(RID rid, ContextPtr &ctx)
     {
         scenes.insert(this);
-        from_json(json::parse(std::ifstream(ctx.resourceManager->GetPath(rid))), *this);
+        FileView file = VirtualFileSystem::Open(ctx.resourceManager->GetPath(rid));
+        from_json(json::parse(file.AsString()), *this);
     }
 
     Scene::~Scene()
@@ -81,22 +83,6 @@ namespace DT
         (*registerFunc)(entity, this, RegisterAction::Remove);
     }
 
-    Scene *Scene::LoadResource(RID rid, ContextPtr &ctx)
-    {
-        if (factoryData.count(rid))
-            return factoryData[rid];
-
-        factoryData[rid] = new Scene(rid, ctx);
-
-        return factoryData[rid];
-    }
-
-    void Scene::UnLoadResource(RID rid)
-    {
-        delete factoryData[rid];
-        factoryData.erase(rid);
-    }
-
     void to_json(json &json, Scene &scene)
     {
         scene.isSerializing = true;
@@ -52,9 +52,9 @@ namespace DT
 
     class Scene
     {
-        static inline std::unordered_map<RID, Scene *> factoryData;
-
     public:
+        static constexpr const char *typeName = "Scene";
+
         std::vector<System *> systems;
         static inline std::set<Scene *> scenes;
 
@@ -218,19 +218,6 @@ namespace DT
          */
         void Remove(Entity entity, const std::string &name, ContextPtr &ctx);
 
-        /**
-         * @brief Loads a scene resource from the given resource ID.
-         * @param rid The resource ID of the scene.
-         * @return A pointer to the loaded scene resource.
-         */
-        static Scene *LoadResource(RID rid, ContextPtr &ctx);
-
-        /**
-         * @brief Unloads a scene resource with the given resource ID.
-         * @param rid The resource ID of the scene to unload.
-         */
-        static void UnLoadResource(RID rid);
-
         /**
          * @brief Retrieves the scene associated with the given entt::registry instance.
          * @param registry The entt::registry instance.
@@ -241,4 +228,23 @@ namespace DT
 
     void to_json(json &json, Scene &scene);
     void from_json(const json &j, Scene &scene);
+
+    /**
+     * @brief Scenes deserialize straight into the context they're loaded in, so they're created on the main thread in one go.
+     */
+    template <>
+    struct ResourceTraits<Scene>
+    {
+        static constexpr const char *typeName = Scene::typeName;
+
+        static Scene *Load(RID rid, ContextPtr &ctx)
+        {
+            return new Scene(rid, ctx);
+        }
+
+        static void Destroy(Scene *scene)
+        {
+            delete scene;
+        }
+    };
 }
\ No newline at end of file
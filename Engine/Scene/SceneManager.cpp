@@ -27,8 +27,7 @@ namespace DT
 {
     SceneManager::SceneManager(ContextPtr &ctx)
     {
-        activeScene.rid = ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Sandbox" / "Assets" / "DucktapeProjectSettings.json");
-        activeScene.Reload(ctx);
+        activeScene.Load(ctx.resourceManager->GetRID(DUCKTAPE_ROOT_DIR / "Resources" / "Sandbox" / "Assets" / "DucktapeProjectSettings.json"), ctx);
         activeScene.data->ctx = &ctx;
     }
 
@@ -22,6 +22,9 @@ aryanbaburajan2007@gmail.com
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <Core/Platform.h>
 #include <Scene/Entity.h>
 #include <Core/ContextPtr.h>
@@ -46,12 +49,74 @@ namespace DT
 
     class Scene;
 
+    /**
+     * @brief The components a system reads and writes in Tick, which tells the SystemScheduler what systems it may
+     * tick at the same time.
+     */
+    struct SystemAccess
+    {
+        std::vector<entt::id_type> reads;  /// @brief Components only read.
+        std::vector<entt::id_type> writes; /// @brief Components written, added or removed.
+        bool declared = false;             /// @brief Systems that didn't declare their access tick alone.
+        bool mainThread = true;            /// @brief Whether Tick calls into GL or the renderer and has to run on the main thread.
+
+        template <typename... Components>
+        SystemAccess &Read()
+        {
+            (reads.push_back(entt::type_hash<Components>::value()), ...);
+            declared = true;
+            return *this;
+        }
+
+        template <typename... Components>
+        SystemAccess &Write()
+        {
+            (writes.push_back(entt::type_hash<Components>::value()), ...);
+            declared = true;
+            return *this;
+        }
+
+        /**
+         * @brief Lets Tick run on a worker thread.
+         */
+        SystemAccess &AnyThread()
+        {
+            mainThread = false;
+            return *this;
+        }
+
+        /**
+         * @brief Whether ticking both systems at the same time could race, one writing what the other touches.
+         */
+        bool ConflictsWith(const SystemAccess &other) const
+        {
+            if (!declared || !other.declared)
+                return true;
+
+            auto touches = [](const SystemAccess &access, entt::id_type component)
+            {
+                return std::find(access.reads.begin(), access.reads.end(), component) != access.reads.end() ||
+                       std::find(access.writes.begin(), access.writes.end(), component) != access.writes.end();
+            };
+
+            for (entt::id_type component : writes)
+                if (touches(other, component))
+                    return true;
+            for (entt::id_type component : other.writes)
+                if (touches(*this, component))
+                    return true;
+            return false;
+        }
+    };
+
     /**
      * @brief The System class represents a base class for systems in the application.
      */
     class System
     {
     public:
+        SystemAccess access; /// @brief What Tick touches, declared in the constructor of the system.
+
         /**
          * @brief Initializes the system.
          * @param ctx A pointer to the application context.
@@ -0,0 +1,129 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include <Core/JobSystem.h>
+#include <Scene/Scene.h>
+#include <Scene/SystemScheduler.h>
+
+namespace DT
+{
+    void SystemScheduler::Tick(Scene &scene, ContextPtr &ctx)
+    {
+        std::vector<System *> &systems = scene.systems;
+
+        if (!parallel)
+        {
+            for (System *system : systems)
+                system->Tick(ctx);
+            return;
+        }
+
+        if (systems != graphSystems)
+            Build(systems);
+
+        finished = 0;
+        for (size_t i = 0; i < systems.size(); i++)
+            remaining[i] = graph[i].dependencies;
+
+        for (size_t i = 0; i < systems.size(); i++)
+            if (graph[i].dependencies == 0)
+                Dispatch(i, systems, ctx);
+
+        // Tick main thread systems as they become ready, and help the workers in between
+        while (finished < systems.size())
+        {
+            size_t next = systems.size();
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+                if (!mainThreadReady.empty())
+                {
+                    next = mainThreadReady.back();
+                    mainThreadReady.pop_back();
+                }
+            }
+
+            if (next < systems.size())
+            {
+                systems[next]->Tick(ctx);
+                Finish(next, systems, ctx);
+            }
+            else if (!ctx.jobSystem->RunPendingJob())
+                std::this_thread::yield();
+        }
+    }
+
+    void SystemScheduler::Build(const std::vector<System *> &systems)
+    {
+        graph.assign(systems.size(), Node());
+        graphSystems = systems;
+        remaining = std::make_unique<std::atomic<unsigned int>[]>(systems.size());
+
+        // Every system depends on the earlier ones it conflicts with, main thread systems also on the earlier main
+        // thread systems so they keep their registration order
+        std::vector<unsigned int> batch(systems.size(), 1);
+        batchCount = 0;
+        for (size_t i = 0; i < systems.size(); i++)
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                const SystemAccess &earlier = systems[j]->access, &later = systems[i]->access;
+                if (!earlier.ConflictsWith(later) && !(earlier.mainThread && later.mainThread))
+                    continue;
+
+                graph[j].dependents.push_back(i);
+                graph[i].dependencies++;
+                batch[i] = std::max(batch[i], batch[j] + 1);
+            }
+            batchCount = std::max(batchCount, batch[i]);
+        }
+
+        std::cout << "[LOG] Scheduled " << systems.size() << " systems in " << batchCount << " batches\n";
+    }
+
+    void SystemScheduler::Finish(size_t index, const std::vector<System *> &systems, ContextPtr &ctx)
+    {
+        for (size_t dependent : graph[index].dependents)
+            if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Dispatch(dependent, systems, ctx);
+
+        finished.fetch_add(1, std::memory_order_release);
+    }
+
+    void SystemScheduler::Dispatch(size_t index, const std::vector<System *> &systems, ContextPtr &ctx)
+    {
+        if (systems[index]->access.mainThread)
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            mainThreadReady.push_back(index);
+            return;
+        }
+
+        ctx.jobSystem->Submit([this, index, &systems, &ctx]()
+                              {
+                                  systems[index]->Tick(ctx);
+                                  Finish(index, systems, ctx); });
+    }
+}
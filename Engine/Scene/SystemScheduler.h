@@ -0,0 +1,73 @@
+/*
+Ducktape | An open source C++ 2D & 3D game engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Scene/System.h>
+#include <Core/ContextPtr.h>
+
+namespace DT
+{
+    /**
+     * @brief Ticks the systems of a scene, running systems whose declared access doesn't conflict at the same time.
+     *
+     * Systems that conflict tick in the order they were registered in. Systems that need the main thread tick on the
+     * calling thread in registration order, the others on the JobSystem's workers.
+     */
+    class SystemScheduler
+    {
+    public:
+        bool parallel = true; /// @brief Whether systems may tick concurrently, otherwise they tick one after another in registration order.
+
+        /**
+         * @brief Ticks every system of the scene once and returns when all of them finished. Must be called from the main thread.
+         */
+        void Tick(Scene &scene, ContextPtr &ctx);
+
+        unsigned int GetBatchCount() const { return batchCount; } /// @brief Length of the longest chain of conflicting systems, the fewest rounds the systems can tick in.
+
+    private:
+        struct Node
+        {
+            std::vector<size_t> dependents; /// @brief Later systems conflicting with this one.
+            unsigned int dependencies = 0;  /// @brief Earlier systems conflicting with this one.
+        };
+
+        std::vector<Node> graph;
+        std::vector<System *> graphSystems; /// @brief The systems graph was built for.
+        unsigned int batchCount = 0;
+
+        std::unique_ptr<std::atomic<unsigned int>[]> remaining; /// @brief Unfinished dependencies of each system this frame.
+        std::atomic<size_t> finished{0};
+        std::mutex readyMutex;
+        std::vector<size_t> mainThreadReady; /// @brief Main thread systems whose dependencies finished.
+
+        void Build(const std::vector<System *> &systems);
+        void Finish(size_t index, const std::vector<System *> &systems, ContextPtr &ctx);
+        void Dispatch(size_t index, const std::vector<System *> &systems, ContextPtr &ctx);
+    };
+}
@@ -1,6 +1,4 @@
 #ifdef DT_SHADER_FRAG
-    #define MAX_LIGHT_NO 25
-
     struct Material {
         sampler2D diffuse;
         sampler2D specular;
@@ -10,33 +8,54 @@
         vec3 ambientColor;
     }; 
 
+    // Member order follows std430 packing, mirrored by DT::PointLightData and DT::DirectionalLightData
     struct DirectionalLight {
         vec3 direction;
-
+        float padding0;
         vec3 ambient;
+        float padding1;
         vec3 diffuse;
+        float padding2;
         vec3 specular;
-
-        bool enabled;
+        float padding3;
     };
 
-    struct PointLight {    
+    struct PointLight {
         vec3 position;
-        
         float constant;
-        float linear;
-        float quadratic;  
 
         vec3 ambient;
+        float linear;
         vec3 diffuse;
+        float quadratic;
         vec3 specular;
+        float radius;
+    };
+
+    // Mirrored by DT::LightGridBlock
+    layout (std140) uniform LightGridBlock {
+        uvec4 gridSize;    // x, y, z cluster counts, w = directional light count
+        vec4 depthParams;  // near, far, depth slice scale
+        vec4 screenSize;
+    } lightGrid;
+
+    layout (std430) readonly buffer PointLightBuffer {
+        PointLight pointLights[];
+    };
+
+    layout (std430) readonly buffer DirectionalLightBuffer {
+        DirectionalLight directionalLights[];
+    };
+
+    // offset and count of each cluster's lights in lightIndices
+    layout (std430) readonly buffer LightClusterBuffer {
+        uvec2 lightClusters[];
+    };
 
-        bool enabled;
-    };  
+    layout (std430) readonly buffer LightIndexBuffer {
+        uint lightIndices[];
+    };
 
-    uniform vec3 viewPos;
-    uniform PointLight pointLights[MAX_LIGHT_NO];
-    uniform DirectionalLight directionalLights[MAX_LIGHT_NO];
     uniform Material material;
 
     in vec3 Normal;
@@ -86,24 +105,32 @@
         return (ambient + diffuse + specular);
     }
 
+    uint ClusterIndex()
+    {
+        float depth = -(camera.view * vec4(FragPos, 1.0)).z;
+        uint slice = uint(clamp(log(depth / lightGrid.depthParams.x) * lightGrid.depthParams.z, 0.0, float(lightGrid.gridSize.z - 1u)));
+        uvec2 tile = min(uvec2(gl_FragCoord.xy / lightGrid.screenSize.xy * vec2(lightGrid.gridSize.xy)), lightGrid.gridSize.xy - 1u);
+
+        return tile.x + tile.y * lightGrid.gridSize.x + slice * lightGrid.gridSize.x * lightGrid.gridSize.y;
+    }
+
     vec4 Frag()
     {
         // Properties
         vec3 norm = normalize(Normal);
-        vec3 viewDir = normalize(viewPos - FragPos);
+        vec3 viewDir = normalize(camera.viewPos.xyz - FragPos);
 
         vec3 result = vec3(0);
         
         // Directional Lights
-        for(int i = 0; i < MAX_LIGHT_NO; i++)
-            if (directionalLights[i].enabled)
-                result += CalculateDirLight(directionalLights[i], norm, viewDir);
-
-        // Point Lights
-        for(int i = 0; i < MAX_LIGHT_NO; i++)
-            if (pointLights[i].enabled)
-                result += CalculatePointLight(pointLights[i], norm, FragPos, viewDir);
-                
+        for(uint i = 0; i < lightGrid.gridSize.w; i++)
+            result += CalculateDirLight(directionalLights[i], norm, viewDir);
+
+        // Point Lights, only the ones binned into this fragment's cluster
+        uvec2 cluster = lightClusters[ClusterIndex()];
+        for(uint i = 0; i < cluster.y; i++)
+            result += CalculatePointLight(pointLights[lightIndices[cluster.x + i]], norm, FragPos, viewDir);
+
         return vec4(result, 1.0);
     }
 #endif
@@ -112,22 +139,19 @@
     layout (location = 0) in vec3 aPos;
     layout (location = 1) in vec3 aNormal;
     layout (location = 2) in vec2 aTexCoords;
+    layout (location = 7) in mat4 aModel; // Per-instance, occupies locations 7-10
 
     out vec2 TexCoords;
     out vec3 Normal;
     out vec3 FragPos;
 
-    uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
-
     vec4 Vert()
     {
-        FragPos = vec3(model * vec4(aPos, 1.0));
-        Normal = mat3(transpose(inverse(model))) * aNormal; // OPTIMIZATION: Calculate this on CPU for inverse() is a heavy operation
+        FragPos = vec3(aModel * vec4(aPos, 1.0));
+        Normal = mat3(transpose(inverse(aModel))) * aNormal; // OPTIMIZATION: Calculate this on CPU for inverse() is a heavy operation
         TexCoords = aTexCoords;
 
-        return projection * view * vec4(FragPos, 1.0);
+        return camera.projection * camera.view * vec4(FragPos, 1.0);
     }
 #endif
 
@@ -0,0 +1,114 @@
+/*
+Ducktape | An open source C++ 2D & 3D game Engine that focuses on being fast, and powerful.
+Copyright (C) 2022 Aryan Baburajan
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+In case of any further questions feel free to contact me at
+the following email address:
+aryanbaburajan2007@gmail.com
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Core/ResourceManager.h>
+#include <Core/PackFile.h>
+
+using namespace DT;
+
+// Packs a project the way the editor's Tools menu does, without opening a window
+int main(int argc, char **argv)
+{
+    std::filesystem::path projectPath, packPath;
+    PackFile::Compression compression = PackFile::Compression::LZ4High;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--none")
+            compression = PackFile::Compression::None;
+        else if (argument == "--fast")
+            compression = PackFile::Compression::LZ4;
+        else if (argument == "--high")
+            compression = PackFile::Compression::LZ4High;
+        else if (projectPath.empty())
+            projectPath = argument;
+        else if (packPath.empty())
+            packPath = argument;
+        else
+            projectPath.clear();
+    }
+
+    if (projectPath.empty())
+    {
+        std::cout << "Usage: DucktapePackBuilder <project file> [output pack] [--none | --fast | --high]\n"
+                  << "Packs every file under the project directory, into Build/" << PackFile::fileName << " next to the project file by default.\n"
+                  << "Blobs are compressed with high LZ4 unless --none or --fast is given.\n";
+        return 1;
+    }
+
+    std::filesystem::path root = std::filesystem::absolute(projectPath).parent_path();
+    if (packPath.empty())
+        packPath = root / "Build" / PackFile::fileName;
+    packPath = std::filesystem::absolute(packPath);
+
+    // The project file knows the RIDs the editor handed out, the pack keeps them
+    ResourceManager resourceManager;
+    std::ifstream project(projectPath);
+    if (!project)
+    {
+        std::cout << "[ERR] [PROJECT_OPEN_FAIL] [" << projectPath.string() << "]\n";
+        return 1;
+    }
+    try
+    {
+        json data = json::parse(project);
+        if (data.contains("resourceManager"))
+            data.at("resourceManager").get_to(resourceManager);
+    }
+    catch (json::exception &e)
+    {
+        std::cout << "[ERR] [JSON] " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Files the editor never registered get new RIDs, in path order so rebuilding the pack gives the same ones
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator it(root, error), end;
+    for (; !error && it != end; it.increment(error))
+    {
+        const std::filesystem::path &path = it->path();
+        if (it->is_directory(error))
+        {
+            if (path.filename() == ".git" || path == packPath.parent_path())
+                it.disable_recursion_pending();
+            continue;
+        }
+        if (it->is_regular_file(error) && path != packPath && path.extension() != ".tmp")
+            files.push_back(path);
+    }
+    std::sort(files.begin(), files.end());
+    for (const std::filesystem::path &path : files)
+        resourceManager.GetRID(path);
+
+    if (!PackFile::Build(resourceManager, root, packPath, compression))
+        return 1;
+
+    std::cout << "[LOG] Packed " << projectPath.string() << " into " << packPath.string() << "\n";
+    return 0;
+}